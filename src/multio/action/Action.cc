@@ -9,6 +9,7 @@
 #include "eckit/runtime/Main.h"
 
 #include "multio/LibMultio.h"
+#include "multio/util/TraceSpan.h"
 
 
 namespace multio::action {
@@ -20,9 +21,26 @@ using eckit::Log;
 //----------------------------------------------------------------------------------------------------------------------
 
 Action::Action(const ComponentConfiguration& compConf) :
-    FailureAware(compConf), compConf_(compConf), type_{compConf.parsedConfig().getString("type")} {}
+    FailureAware(compConf), compConf_(compConf), type_{compConf.parsedConfig().getString("type")} {
+    auto& metrics = util::Metrics::instance();
+    if (metrics.enabled()) {
+        const auto labels = util::metricsLabel("plan", compConf.parsedConfig().getString("plan-name", "")) + ","
+                          + util::metricsLabel("action", type_);
+        latency_ = &metrics.histogram("multio_action_latency_seconds", labels,
+                                      "Time to execute an action, including the actions following it");
+        messages_ = &metrics.counter("multio_action_messages", labels, "Messages passed to an action");
+        bytes_ = &metrics.counter("multio_action_bytes", labels, "Payload bytes passed to an action");
+    }
+}
 
 void Action::execute(message::Message msg) {
+    if (messages_) {
+        messages_->add();
+        bytes_->add(msg.size());
+    }
+    util::ScopedLatency latency{latency_};
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_ACTION, util::traceFieldKey(msg.metadata()));
+
     auto lmsg = msg.logMessage();
     withFailureHandling([&, msg = std::move(msg)]() mutable { executeImpl(std::move(msg)); },
                         [&, lmsg = std::move(lmsg)]() {
@@ -27,6 +27,7 @@
 #include "multio/config/ComponentConfiguration.h"
 #include "multio/message/Message.h"
 #include "multio/util/FailureHandling.h"
+#include "multio/util/Metrics.h"
 
 namespace multio::message::match {
 class MatchReduce;
@@ -75,6 +76,11 @@ protected:
     mutable ActionStatistics statistics_;
 
 private:
+    // Live metrics, only set if metrics are exported
+    util::LatencyHistogram* latency_ = nullptr;
+    util::MetricsCounter* messages_ = nullptr;
+    util::MetricsCounter* bytes_ = nullptr;
+
     virtual void executeImpl(message::Message msg) = 0;
 
     virtual void print(std::ostream& os) const = 0;
@@ -0,0 +1,103 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/action/ElementwiseStage.h"
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+
+#include "multio/LibMultio.h"
+
+
+namespace multio::action {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::size_t payloadValues(const message::Message& msg) {
+    return util::dispatchPrecisionTag(msg.precision(), [&](auto pt) -> std::size_t {
+        using Precision = typename decltype(pt)::type;
+        return msg.payload().size() / sizeof(Precision);
+    });
+}
+
+void applyInPlace(ElementwiseKernel& kernel, message::Message& msg) {
+    ASSERT(!kernel.convertsTo());
+
+    const auto precision = msg.precision();
+
+    if (kernel.modifiesPayload()) {
+        msg.acquire();
+    }
+    else {
+        msg.acquireMetadata();
+    }
+    // Now metadata and payload can be modified
+
+    kernel.updateMetadata(msg.modifyMetadata());
+
+    if (kernel.modifiesPayload()) {
+        util::dispatchPrecisionTag(precision, [&](auto pt) {
+            using Precision = typename decltype(pt)::type;
+            kernel.apply(static_cast<Precision*>(msg.payload().modifyData()), 0,
+                         msg.payload().size() / sizeof(Precision));
+        });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+ElementwiseStageFactory& ElementwiseStageFactory::instance() {
+    static ElementwiseStageFactory singleton;
+    return singleton;
+}
+
+void ElementwiseStageFactory::enregister(const std::string& name, const ElementwiseStageBuilderBase* builder) {
+    std::lock_guard<std::recursive_mutex> lock{mutex_};
+    ASSERT(factories_.find(name) == factories_.end());
+    factories_[name] = builder;
+}
+
+void ElementwiseStageFactory::deregister(const std::string& name) {
+    std::lock_guard<std::recursive_mutex> lock{mutex_};
+    ASSERT(factories_.find(name) != factories_.end());
+    factories_.erase(name);
+}
+
+bool ElementwiseStageFactory::has(const std::string& name) {
+    std::lock_guard<std::recursive_mutex> lock{mutex_};
+    return factories_.find(name) != factories_.end();
+}
+
+std::unique_ptr<ElementwiseStage> ElementwiseStageFactory::build(const std::string& name,
+                                                                 const ComponentConfiguration& compConf) {
+    std::lock_guard<std::recursive_mutex> lock{mutex_};
+
+    LOG_DEBUG_LIB(LibMultio) << "Looking for ElementwiseStageFactory [" << name << "]" << std::endl;
+
+    auto f = factories_.find(name);
+
+    if (f != factories_.end())
+        return f->second->make(compConf);
+
+    throw eckit::SeriousBug(std::string("No ElementwiseStageFactory called ") + name);
+}
+
+
+ElementwiseStageBuilderBase::ElementwiseStageBuilderBase(const std::string& name) : name_(name) {
+    ElementwiseStageFactory::instance().enregister(name, this);
+}
+
+ElementwiseStageBuilderBase::~ElementwiseStageBuilderBase() {
+    ElementwiseStageFactory::instance().deregister(name_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::action
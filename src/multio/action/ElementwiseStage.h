@@ -0,0 +1,137 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "eckit/memory/NonCopyable.h"
+
+#include "multio/config/ComponentConfiguration.h"
+#include "multio/message/Message.h"
+#include "multio/util/PrecisionTag.h"
+
+namespace multio::action {
+
+using config::ComponentConfiguration;
+
+//--------------------------------------------------------------------------------------------------
+
+/// Per-message part of an elementwise stage.
+/// The payload is passed in blocks of increasing index: block[0] is the value at index begin.
+class ElementwiseKernel {
+public:
+    virtual ~ElementwiseKernel() = default;
+
+    virtual void updateMetadata(message::Metadata& md) const = 0;
+
+    virtual bool modifiesPayload() const { return true; }
+
+    /// Set for kernels that convert the payload to another precision instead of transforming values
+    virtual std::optional<util::PrecisionTag> convertsTo() const { return std::nullopt; }
+
+    virtual void apply(float* block, std::size_t begin, std::size_t end) = 0;
+    virtual void apply(double* block, std::size_t begin, std::size_t end) = 0;
+};
+
+/// Implements both precisions through `template <typename Precision> void applyImpl(Precision*, size_t, size_t)`
+template <typename Derived>
+class ElementwiseKernelBase : public ElementwiseKernel {
+public:
+    void apply(float* block, std::size_t begin, std::size_t end) override {
+        static_cast<Derived*>(this)->template applyImpl<float>(block, begin, end);
+    }
+    void apply(double* block, std::size_t begin, std::size_t end) override {
+        static_cast<Derived*>(this)->template applyImpl<double>(block, begin, end);
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// Elementwise payload transformation of an action. Consecutive stages can be fused into a single pass over the
+/// payload by the "fused-elementwise" action (see Plan, option "fuse-elementwise-actions").
+class ElementwiseStage : private eckit::NonCopyable {
+public:
+    virtual ~ElementwiseStage() = default;
+
+    /// @param size Number of values in the payload
+    /// @return nullptr if the stage leaves the message untouched
+    virtual std::unique_ptr<ElementwiseKernel> prepare(const message::Metadata& md, std::size_t size) const = 0;
+
+private:
+    virtual void print(std::ostream& os) const = 0;
+
+    friend std::ostream& operator<<(std::ostream& os, const ElementwiseStage& s) {
+        s.print(os);
+        return os;
+    }
+};
+
+/// Number of values in the payload of a field
+std::size_t payloadValues(const message::Message& msg);
+
+/// Applies a kernel to the whole payload in place, as done by the actions when they are not fused
+void applyInPlace(ElementwiseKernel& kernel, message::Message& msg);
+
+//--------------------------------------------------------------------------------------------------
+
+class ElementwiseStageBuilderBase;
+
+class ElementwiseStageFactory : private eckit::NonCopyable {
+private:  // methods
+    ElementwiseStageFactory() {}
+
+public:  // methods
+    static ElementwiseStageFactory& instance();
+
+    void enregister(const std::string& name, const ElementwiseStageBuilderBase* builder);
+    void deregister(const std::string& name);
+
+    bool has(const std::string& name);
+
+    std::unique_ptr<ElementwiseStage> build(const std::string&, const ComponentConfiguration& compConf);
+
+private:  // members
+    std::map<std::string, const ElementwiseStageBuilderBase*> factories_;
+
+    std::recursive_mutex mutex_;
+};
+
+class ElementwiseStageBuilderBase : private eckit::NonCopyable {
+public:  // methods
+    virtual std::unique_ptr<ElementwiseStage> make(const ComponentConfiguration& compConf) const = 0;
+
+protected:  // methods
+    ElementwiseStageBuilderBase(const std::string&);
+
+    virtual ~ElementwiseStageBuilderBase();
+
+    std::string name_;
+};
+
+/// Registered under the same name as the action it belongs to
+template <class T>
+class ElementwiseStageBuilder final : public ElementwiseStageBuilderBase {
+    std::unique_ptr<ElementwiseStage> make(const ComponentConfiguration& compConf) const override {
+        return std::make_unique<T>(compConf);
+    }
+
+public:
+    ElementwiseStageBuilder(const std::string& name) : ElementwiseStageBuilderBase(name) {}
+};
+
+//--------------------------------------------------------------------------------------------------
+
+}  // namespace multio::action
@@ -19,7 +19,9 @@
 
 #include "multio/LibMultio.h"
 #include "multio/action/Action.h"
+#include "multio/action/ElementwiseStage.h"
 #include "multio/config/PlanConfiguration.h"
+#include "multio/message/MetadataMatcher.h"
 #include "multio/util/Substitution.h"
 #include "multio/util/Timing.h"
 
@@ -41,17 +43,64 @@ LocalConfiguration createActionList(std::vector<LocalConfiguration> actions) {
     return current;
 }
 
+// Collapses runs of consecutive actions that provide an elementwise stage into one fused-elementwise action
+std::vector<LocalConfiguration> fuseElementwiseActions(const std::vector<LocalConfiguration>& actions) {
+    std::vector<LocalConfiguration> fused;
+    std::vector<LocalConfiguration> stages;
+
+    auto flush = [&]() {
+        if (stages.size() > 1) {
+            LocalConfiguration cfg;
+            cfg.set("type", "fused-elementwise");
+            cfg.set("stages", stages);
+            fused.push_back(cfg);
+        }
+        else {
+            fused.insert(fused.end(), stages.begin(), stages.end());
+        }
+        stages.clear();
+    };
+
+    for (const auto& action : actions) {
+        if (action.has("type") && ElementwiseStageFactory::instance().has(action.getString("type"))) {
+            stages.push_back(action);
+        }
+        else {
+            flush();
+            fused.push_back(action);
+        }
+    }
+    flush();
+
+    return fused;
+}
+
 LocalConfiguration rootConfig(const LocalConfiguration& config, const std::string& planName) {
-    const auto actions
-        = config.has("actions") ? config.getSubConfigurations("actions") : std::vector<LocalConfiguration>{};
+    auto actions = config.has("actions") ? config.getSubConfigurations("actions") : std::vector<LocalConfiguration>{};
 
     if (actions.empty()) {
         throw eckit::UserError("Plan config must define at least one action. Plan: " + planName);
     }
 
+    if (config.getBool("fuse-elementwise-actions", false)) {
+        actions = fuseElementwiseActions(actions);
+    }
+
+    // Used to label the metrics of the actions
+    for (auto& action : actions) {
+        action.set("plan-name", planName);
+    }
+
     return createActionList(actions);
 }
 
+std::unique_ptr<const message::match::MatchReduce> rootSelector(const LocalConfiguration& root) {
+    if (root.getString("type") != "select") {
+        return nullptr;
+    }
+    return std::make_unique<const message::match::MatchReduce>(message::match::MatchReduce::construct(root));
+}
+
 }  // namespace
 
 std::vector<std::unique_ptr<action::Plan>> Plan::makePlans(
@@ -103,12 +152,40 @@ Plan::Plan(const ComponentConfiguration& compConf) :
     name_{compConf.parsedConfig().getString("name")},
     root_{ActionFactory::instance().build(
         rootConfig(compConf.parsedConfig(), name_).getString("type"),
-        ComponentConfiguration(rootConfig(compConf.parsedConfig(), name_), compConf.multioConfig()))} {}
+        ComponentConfiguration(rootConfig(compConf.parsedConfig(), name_), compConf.multioConfig()))},
+    rootSelector_{rootSelector(rootConfig(compConf.parsedConfig(), name_))},
+    dispatchLatency_{name_, "dispatch"} {
+    auto& metrics = util::Metrics::instance();
+    if (metrics.enabled()) {
+        const auto labels = util::metricsLabel("plan", name_);
+        latency_ = &metrics.histogram("multio_plan_latency_seconds", labels, "Time to process a message by a plan");
+        messages_ = &metrics.counter("multio_plan_messages", labels, "Messages processed by a plan");
+    }
+}
 
-Plan::~Plan() = default;
+Plan::~Plan() {
+    // End-to-end latency of the fields of this plan, from the client write to each stage
+    const auto& metrics = util::Metrics::instance();
+    for (const auto* stage : {"dispatch", "aggregate", "encode", "sink"}) {
+        const auto* h = metrics.findHistogram(util::FieldLatency::metricName, util::metricsLabel("plan", name_) + ","
+                                                                                   + util::metricsLabel("stage", stage));
+        if (h && h->count() > 0) {
+            eckit::Log::info() << "Plan \"" << name_ << "\" field latency at " << stage << ": count " << h->count()
+                               << ", p50 " << h->quantile(0.5) << "s, p90 " << h->quantile(0.9) << "s, p99 "
+                               << h->quantile(0.99) << "s, max " << h->quantile(1.0) << "s" << std::endl;
+        }
+    }
+}
 
 void Plan::process(message::Message msg) {
     util::ScopedTiming<> timer{timing_};
+    util::ScopedLatency latency{latency_};
+    if (messages_) {
+        messages_->add();
+    }
+    if (msg.tag() == message::Message::Tag::Field) {
+        dispatchLatency_.record(msg.origin().time);
+    }
     message::LogMessage lmsg = msg.logMessage();
     withFailureHandling([this, msg = std::move(msg)]() mutable { root_->execute(std::move(msg)); },
                         // For failure handling a copy of the message needs to be captured... Note than the move
@@ -137,5 +214,9 @@ const std::string& Plan::name() const noexcept {
     return name_;
 }
 
+const message::match::MatchReduce* Plan::rootSelector() const noexcept {
+    return rootSelector_.get();
+}
+
 
 }  // namespace multio::action
@@ -25,6 +25,7 @@
 #include "multio/config/MultioConfiguration.h"
 #include "multio/message/Message.h"
 #include "multio/util/FailureHandling.h"
+#include "multio/util/Metrics.h"
 #include "multio/util/Timing.h"
 
 namespace multio::message::match {
@@ -76,10 +77,20 @@ public:
 
     const std::string& name() const noexcept;
 
+    /// Selector every message has to match before any action of the plan is executed.
+    /// nullptr if the plan does not start with a select action.
+    const message::match::MatchReduce* rootSelector() const noexcept;
+
 protected:
     const std::string name_;
     const std::unique_ptr<Action> root_;
+    const std::unique_ptr<const message::match::MatchReduce> rootSelector_;
     util::Timing<> timing_;
+
+    // Live metrics, only set if metrics are exported
+    util::LatencyHistogram* latency_ = nullptr;
+    util::MetricsCounter* messages_ = nullptr;
+    util::FieldLatency dispatchLatency_;
 };
 
 
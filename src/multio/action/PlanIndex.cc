@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "PlanIndex.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#include "eckit/log/Log.h"
+
+#include "multio/LibMultio.h"
+#include "multio/action/Plan.h"
+
+namespace multio::action {
+
+using message::match::MatchKeys;
+
+namespace {
+
+void setBit(std::vector<std::uint64_t>& bits, std::size_t i) {
+    bits[i / 64] |= (std::uint64_t{1} << (i % 64));
+}
+
+void intersect(std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs) {
+    for (std::size_t w = 0; w < lhs.size(); ++w) {
+        lhs[w] &= rhs[w];
+    }
+}
+
+void intersectUnion(std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs1,
+                    const std::vector<std::uint64_t>& rhs2) {
+    for (std::size_t w = 0; w < lhs.size(); ++w) {
+        lhs[w] &= (rhs1[w] | rhs2[w]);
+    }
+}
+
+}  // namespace
+
+
+PlanIndex::PlanIndex(const Plans& plans, std::size_t maxKeys) : all_((plans.size() + 63) / 64, 0) {
+    plans_.reserve(plans.size());
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+        plans_.push_back(plans[i].get());
+        setBit(all_, i);
+    }
+
+    // Index the keys that rule out the most plans
+    std::map<MatchKeys::KeyType, std::size_t> numConstrainedPlans;
+    for (const auto* plan : plans_) {
+        if (const auto* selector = plan->rootSelector()) {
+            std::set<MatchKeys::KeyType> keys;
+            selector->constrainedKeys(keys);
+            for (const auto& key : keys) {
+                if (selector->requiredValues(key)) {
+                    ++numConstrainedPlans[key];
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<MatchKeys::KeyType, std::size_t>> candidates{numConstrainedPlans.begin(),
+                                                                       numConstrainedPlans.end()};
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    candidates.resize(std::min(candidates.size(), maxKeys));
+
+    for (const auto& candidate : candidates) {
+        KeyIndex index{candidate.first, {}, Bitset(all_.size(), 0), {}};
+        for (std::size_t i = 0; i < plans_.size(); ++i) {
+            const auto* selector = plans_[i]->rootSelector();
+            auto values = selector ? selector->requiredValues(index.key) : std::nullopt;
+            if (!values) {
+                setBit(index.unconstrained, i);
+                continue;
+            }
+            for (const auto& value : *values) {
+                auto& bits = index.plansByValue.try_emplace(value, all_.size(), 0).first->second;
+                setBit(bits, i);
+                index.valueTypes.insert(value.index());
+            }
+        }
+        keys_.push_back(std::move(index));
+    }
+
+    LOG_DEBUG_LIB(LibMultio) << *this << std::endl;
+}
+
+PlanIndex::Bitset PlanIndex::lookup(const message::Metadata& md) const {
+    Bitset candidates = all_;
+    for (const auto& index : keys_) {
+        auto searchKey = md.find(index.key);
+        if (searchKey == md.end()) {
+            // Constraining plans require the key
+            intersect(candidates, index.unconstrained);
+            continue;
+        }
+
+        auto searchValue = index.plansByValue.find(searchKey->second);
+        if (searchValue != index.plansByValue.end()) {
+            intersectUnion(candidates, searchValue->second, index.unconstrained);
+        }
+        else if (index.valueTypes.empty() || (index.valueTypes.count(searchKey->second.index()) > 0)) {
+            intersect(candidates, index.unconstrained);
+        }
+        // Otherwise the value is of another type than expected. Keep all plans, their selectors decide (and report
+        // the mismatch when enforcing same key types).
+    }
+    return candidates;
+}
+
+void PlanIndex::print(std::ostream& os) const {
+    os << "PlanIndex(plans=" << plans_.size() << ", keys=[";
+    bool first = true;
+    for (const auto& index : keys_) {
+        os << (first ? "" : ", ") << index.key.value() << " (" << index.plansByValue.size() << " values)";
+        first = false;
+    }
+    os << "])";
+}
+
+}  // namespace multio::action
@@ -0,0 +1,99 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "multio/message/Message.h"
+#include "multio/message/Metadata.h"
+#include "multio/message/MetadataMatcher.h"
+
+namespace multio::action {
+
+class Plan;
+
+/**
+ * Pre-filters plans by the select action they start with, so that a message only visits plans that can match it.
+ *
+ * For the keys constrained by most plans (e.g. param, levtype, category) a hash index maps each value to the set of
+ * plans accepting it. Looking up a message intersects these sets; the remaining plans still evaluate their full
+ * selector. Plans without a leading select action are always visited. Candidates are returned in plan order.
+ */
+class PlanIndex {
+public:
+    using Plans = std::vector<std::unique_ptr<Plan>>;
+
+    /// @param maxKeys Maximum number of metadata keys to index
+    explicit PlanIndex(const Plans& plans, std::size_t maxKeys = 4);
+
+    /// Calls f(plan) for every plan that can match the metadata, in the order of the plans
+    template <typename Func>
+    void forEachCandidate(const message::Metadata& md, Func&& f) const {
+        const auto candidates = lookup(md);
+        for (std::size_t w = 0; w < candidates.size(); ++w) {
+            std::uint64_t word = candidates[w];
+            while (word != 0) {
+                const auto bit = static_cast<std::size_t>(__builtin_ctzll(word));
+                f(*plans_[w * 64 + bit]);
+                word &= word - 1;
+            }
+        }
+    }
+
+    /// Calls f(plan, msg) for every message of a batch and every plan that can match it. Plan-major: each plan handles
+    /// all its messages before the next plan, in the order of the batch.
+    template <typename Func>
+    void forEachCandidate(const std::vector<message::Message>& batch, Func&& f) const {
+        std::vector<Bitset> candidates;
+        candidates.reserve(batch.size());
+        for (const auto& msg : batch) {
+            candidates.push_back(lookup(msg.metadata()));
+        }
+        for (std::size_t p = 0; p < plans_.size(); ++p) {
+            const std::uint64_t bit = std::uint64_t{1} << (p % 64);
+            for (std::size_t m = 0; m < batch.size(); ++m) {
+                if (candidates[m][p / 64] & bit) {
+                    f(*plans_[p], batch[m]);
+                }
+            }
+        }
+    }
+
+private:
+    using Bitset = std::vector<std::uint64_t>;
+
+    struct KeyIndex {
+        message::match::MatchKeys::KeyType key;
+        std::unordered_map<message::MetadataValue, Bitset> plansByValue;
+        Bitset unconstrained;                        // Plans that accept any value or a missing key
+        std::unordered_set<std::size_t> valueTypes;  // Variant indices of the indexed values
+    };
+
+    Bitset lookup(const message::Metadata& md) const;
+
+    void print(std::ostream& os) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const PlanIndex& index) {
+        index.print(os);
+        return os;
+    }
+
+    std::vector<Plan*> plans_;
+    std::vector<KeyIndex> keys_;
+    Bitset all_;
+};
+
+}  // namespace multio::action
@@ -19,12 +19,15 @@ namespace multio::action {
 
 using message::Peer;
 
-Aggregate::Aggregate(const ComponentConfiguration& compConf) : ChainedAction(compConf) {}
+Aggregate::Aggregate(const ComponentConfiguration& compConf) :
+    ChainedAction(compConf), aggregatedLatency_{compConf.parsedConfig().getString("plan-name", ""), "aggregate"} {}
 
 void Aggregate::executeImpl(Message msg) {
 
     if ((msg.tag() == Message::Tag::Field) && handleField(msg)) {
-        executeNext(globalField(msg.fieldId()));
+        auto global = globalField(msg.fieldId());
+        aggregatedLatency_.record(global.origin().time);
+        executeNext(std::move(global));
     }
 
     if ((msg.tag() == Message::Tag::Flush) && handleFlush(msg)) {
@@ -43,6 +46,13 @@ bool Aggregate::handleField(const Message& msg) {
         .at(msg.source())
         ->toGlobal(msg, aggCatalogue_.getMessage(msg.fieldId()));
     aggCatalogue_.bookProcessedPart(msg.fieldId(), msg.source());
+
+    // The global field is as old as its earliest part
+    auto& global = aggCatalogue_.getMessage(msg.fieldId()).header();
+    if (msg.origin().time != 0 && (global.origin().time == 0 || msg.origin().time < global.origin().time)) {
+        global.setOrigin(msg.origin());
+    }
+
     return allPartsArrived(msg);
 }
 
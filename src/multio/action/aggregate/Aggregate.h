@@ -46,6 +46,7 @@ private:
     auto flushCount(const Message& msg);
 
     AggregationCatalogue aggCatalogue_;
+    util::FieldLatency aggregatedLatency_;
     std::map<std::string, std::set<message::Peer>> flushes_;
 };
 
@@ -0,0 +1,95 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "ConvertPrecision.h"
+
+#include <iostream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "multio/message/Message.h"
+
+namespace multio::action {
+
+namespace {
+
+util::PrecisionTag fetchPrecision(const eckit::Configuration& cfg) {
+    if (!cfg.has("precision")) {
+        throw eckit::UserError("ConvertPrecision: configuration requires \"precision\" (single or double)", Here());
+    }
+    return util::decodePrecisionTag(cfg.getString("precision"));
+}
+
+class ConvertPrecisionKernel final : public ElementwiseKernel {
+public:
+    ConvertPrecisionKernel(util::PrecisionTag precision, std::size_t size) : precision_{precision}, size_{size} {}
+
+    void updateMetadata(message::Metadata& md) const override {
+        md.set("precision", precision_ == util::PrecisionTag::Double ? "double" : "single");
+        md.set<std::int64_t>("globalSize", size_);
+    }
+
+    std::optional<util::PrecisionTag> convertsTo() const override { return precision_; }
+
+    // Values are untouched, the conversion happens when the block is copied into the target precision
+    void apply(float*, std::size_t, std::size_t) override {}
+    void apply(double*, std::size_t, std::size_t) override {}
+
+private:
+    util::PrecisionTag precision_;
+    std::size_t size_;
+};
+
+}  // namespace
+
+
+ConvertPrecisionStage::ConvertPrecisionStage(const ComponentConfiguration& compConf) :
+    precision_{fetchPrecision(compConf.parsedConfig())} {}
+
+std::unique_ptr<ElementwiseKernel> ConvertPrecisionStage::prepare(const message::Metadata& md,
+                                                                   std::size_t size) const {
+    if (util::decodePrecisionTag(md.get<std::string>("precision")) == precision_) {
+        return nullptr;
+    }
+    return std::make_unique<ConvertPrecisionKernel>(precision_, size);
+}
+
+void ConvertPrecisionStage::print(std::ostream& os) const {
+    os << "ConvertPrecision(precision=" << (precision_ == util::PrecisionTag::Double ? "double" : "single") << ")";
+}
+
+
+ConvertPrecision::ConvertPrecision(const ComponentConfiguration& compConf) :
+    ChainedAction(compConf), stage_{compConf} {}
+
+void ConvertPrecision::executeImpl(message::Message msg) {
+    if ((msg.tag() != message::Message::Tag::Field) || (msg.precision() == stage_.precision())) {
+        executeNext(std::move(msg));
+        return;
+    }
+
+    message::Message converted = [&]() {
+        util::ScopedTiming timing{statistics_.actionTiming_};
+        return stage_.precision() == util::PrecisionTag::Double
+                 ? message::convert_precision<float, double>(std::move(msg))
+                 : message::convert_precision<double, float>(std::move(msg));
+    }();
+
+    executeNext(std::move(converted));
+}
+
+void ConvertPrecision::print(std::ostream& os) const {
+    os << stage_;
+}
+
+static ActionBuilder<ConvertPrecision> ConvertPrecisionBuilder("convert-precision");
+static ElementwiseStageBuilder<ConvertPrecisionStage> ConvertPrecisionStageBuilder("convert-precision");
+
+}  // namespace multio::action
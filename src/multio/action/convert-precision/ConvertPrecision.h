@@ -0,0 +1,50 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+
+#include "multio/action/ChainedAction.h"
+#include "multio/action/ElementwiseStage.h"
+#include "multio/util/PrecisionTag.h"
+
+namespace multio::action {
+
+// Converting the payload precision as elementwise stage. The conversion itself is performed by the action or by a
+// fused elementwise pipeline; the kernel only announces the target precision.
+class ConvertPrecisionStage final : public ElementwiseStage {
+public:
+    explicit ConvertPrecisionStage(const ComponentConfiguration& compConf);
+
+    std::unique_ptr<ElementwiseKernel> prepare(const message::Metadata& md, std::size_t size) const override;
+
+    util::PrecisionTag precision() const { return precision_; }
+
+private:
+    void print(std::ostream& os) const override;
+
+    util::PrecisionTag precision_;
+};
+
+
+class ConvertPrecision final : public ChainedAction {
+public:
+    explicit ConvertPrecision(const ComponentConfiguration& compConf);
+
+    void executeImpl(message::Message msg) override;
+
+private:
+    void print(std::ostream& os) const override;
+
+    ConvertPrecisionStage stage_;
+};
+
+}  // namespace multio::action
@@ -29,6 +29,7 @@
 #include "multio/LibMultio.h"
 #include "multio/config/PathConfiguration.h"
 #include "multio/util/Timing.h"
+#include "multio/util/TraceSpan.h"
 
 namespace multio::action {
 
@@ -219,7 +220,8 @@ Encode::Encode(const ComponentConfiguration& compConf, const eckit::LocalConfigu
                                 : (encConf.has("run") ? eckit::LocalConfiguration{encConf.getSubConfiguration("run")}
                                                       : eckit::LocalConfiguration{}))},
     encoder_{makeEncoder(encConf, compConf.multioConfig())},
-    gridDownloader_{std::make_unique<multio::action::GridDownloader>(compConf)} {}
+    gridDownloader_{std::make_unique<multio::action::GridDownloader>(compConf)},
+    encodedLatency_{compConf.parsedConfig().getString("plan-name", ""), "encode"} {}
 
 Encode::Encode(const ComponentConfiguration& compConf) : Encode(compConf, getEncodingConfiguration(compConf)) {}
 
@@ -274,12 +276,16 @@ message::Message Encode::encodeField(const message::Message& message, const std:
     auto logMsg = message.logMessage();
     try {
         util::ScopedTiming timing{statistics_.actionTiming_};
+        MULTIO_TRACE_SPAN(util::MULTIO_SPAN_ENCODE, util::traceFieldKey(message.metadata()));
         message::Message msg{message};
         msg.header().acquireMetadata();
         if (gridUID) {
             msg.modifyMetadata().set("uuidOfHGrid", gridUID.value());
         }
-        return encoder_->encodeField(std::move(msg), overwrite_, additionalMetadata_);
+        auto encoded = encoder_->encodeField(std::move(msg), overwrite_, additionalMetadata_);
+        encoded.header().setOrigin(message.origin());
+        encodedLatency_.record(message.origin().time);
+        return encoded;
     }
     catch (const std::exception& ex) {
         std::ostringstream oss;
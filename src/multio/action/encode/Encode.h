@@ -46,6 +46,7 @@ private:
 
     const std::unique_ptr<GribEncoder> encoder_ = nullptr;
     const std::unique_ptr<GridDownloader> gridDownloader_ = nullptr;
+    util::FieldLatency encodedLatency_;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,197 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "FusedElementwise.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <type_traits>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
+
+#include "multio/util/PrecisionTag.h"
+
+namespace multio::action {
+
+namespace {
+
+// Number of values processed by all stages before moving on. Two blocks of doubles fit in a typical L1 cache.
+constexpr std::size_t BlockSize = 1024;
+
+std::vector<std::unique_ptr<ElementwiseStage>> makeStages(const ComponentConfiguration& compConf) {
+    std::vector<std::unique_ptr<ElementwiseStage>> stages;
+    for (auto&& stageConf : compConf.subComponents("stages")) {
+        stages.emplace_back(
+            ElementwiseStageFactory::instance().build(stageConf.parsedConfig().getString("type"), stageConf));
+    }
+    if (stages.empty()) {
+        throw eckit::UserError("FusedElementwise: configuration requires at least one entry in \"stages\"", Here());
+    }
+    return stages;
+}
+
+struct PreparedKernel {
+    std::unique_ptr<ElementwiseKernel> kernel;
+    util::PrecisionTag precision;  // Precision of the values the kernel is applied to
+};
+
+// Block buffers for both precisions, used when the pipeline converts precision
+struct ConversionBlocks {
+    std::array<float, BlockSize> floats;
+    std::array<double, BlockSize> doubles;
+
+    template <typename Precision>
+    Precision* get() {
+        if constexpr (std::is_same_v<Precision, float>) {
+            return floats.data();
+        }
+        else {
+            return doubles.data();
+        }
+    }
+};
+
+template <typename From>
+void convertBlock(ConversionBlocks& blocks, std::size_t n) {
+    if constexpr (std::is_same_v<From, float>) {
+        std::copy(blocks.floats.begin(), blocks.floats.begin() + n, blocks.doubles.begin());
+    }
+    else {
+        std::transform(blocks.doubles.begin(), blocks.doubles.begin() + n, blocks.floats.begin(),
+                       [](double v) { return static_cast<float>(v); });
+    }
+}
+
+void applyBlock(ElementwiseKernel& kernel, util::PrecisionTag precision, ConversionBlocks& blocks, std::size_t begin,
+                std::size_t end) {
+    util::dispatchPrecisionTag(precision, [&](auto pt) {
+        using Precision = typename decltype(pt)::type;
+        if (kernel.convertsTo()) {
+            convertBlock<Precision>(blocks, end - begin);
+        }
+        else {
+            kernel.apply(blocks.get<Precision>(), begin, end);
+        }
+    });
+}
+
+}  // namespace
+
+
+FusedElementwise::FusedElementwise(const ComponentConfiguration& compConf) :
+    ChainedAction(compConf), stages_{makeStages(compConf)} {}
+
+void FusedElementwise::executeImpl(message::Message msg) {
+    if (msg.tag() != message::Message::Tag::Field) {
+        executeNext(std::move(msg));
+        return;
+    }
+
+    {
+        util::ScopedTiming timing{statistics_.actionTiming_};
+
+        const auto inputPrecision = msg.precision();
+        const std::size_t size = payloadValues(msg);
+
+        // Each stage sees the metadata as left by the previous stages
+        message::Metadata md = msg.metadata();
+        std::vector<PreparedKernel> kernels;
+        auto precision = inputPrecision;
+        bool modifiesPayload = false;
+        bool converts = false;
+        for (const auto& stage : stages_) {
+            if (auto kernel = stage->prepare(md, size)) {
+                kernel->updateMetadata(md);
+                modifiesPayload = modifiesPayload || kernel->modifiesPayload();
+                kernels.push_back(PreparedKernel{std::move(kernel), precision});
+                if (auto target = kernels.back().kernel->convertsTo()) {
+                    precision = *target;
+                    converts = true;
+                }
+            }
+        }
+
+        if (!converts) {
+            if (modifiesPayload) {
+                msg.acquire();
+            }
+            else {
+                msg.acquireMetadata();
+            }
+            // Now metadata and payload can be modified
+
+            msg.modifyMetadata() = std::move(md);
+
+            if (modifiesPayload) {
+                util::dispatchPrecisionTag(precision, [&](auto pt) {
+                    using Precision = typename decltype(pt)::type;
+                    auto* data = static_cast<Precision*>(msg.payload().modifyData());
+                    for (std::size_t begin = 0; begin < size; begin += BlockSize) {
+                        const std::size_t end = std::min(begin + BlockSize, size);
+                        for (auto& k : kernels) {
+                            if (k.kernel->modifiesPayload()) {
+                                k.kernel->apply(data + begin, begin, end);
+                            }
+                        }
+                    }
+                });
+            }
+        }
+        else {
+            // Blocks are processed in local buffers and written once, in the output precision
+            eckit::Buffer buffer(size * (precision == util::PrecisionTag::Double ? sizeof(double) : sizeof(float)));
+            auto blocks = std::make_unique<ConversionBlocks>();
+
+            for (std::size_t begin = 0; begin < size; begin += BlockSize) {
+                const std::size_t end = std::min(begin + BlockSize, size);
+
+                util::dispatchPrecisionTag(inputPrecision, [&](auto pt) {
+                    using Precision = typename decltype(pt)::type;
+                    const auto* in = static_cast<const Precision*>(msg.payload().data());
+                    std::copy(in + begin, in + end, blocks->get<Precision>());
+                });
+
+                for (auto& k : kernels) {
+                    if (k.kernel->modifiesPayload()) {
+                        applyBlock(*k.kernel, k.precision, *blocks, begin, end);
+                    }
+                }
+
+                util::dispatchPrecisionTag(precision, [&](auto pt) {
+                    using Precision = typename decltype(pt)::type;
+                    auto* out = static_cast<Precision*>(buffer.data());
+                    std::copy(blocks->get<Precision>(), blocks->get<Precision>() + (end - begin), out + begin);
+                });
+            }
+
+            message::Message::Header header{msg.tag(), msg.source(), msg.destination(), std::move(md)};
+            header.setOrigin(msg.origin());
+            msg = message::Message{std::move(header), std::move(buffer)};
+        }
+    }
+
+    executeNext(std::move(msg));
+}
+
+void FusedElementwise::print(std::ostream& os) const {
+    os << "FusedElementwise(";
+    bool first = true;
+    for (const auto& stage : stages_) {
+        os << (first ? "" : " -> ") << *stage;
+        first = false;
+    }
+    os << ")";
+}
+
+static ActionBuilder<FusedElementwise> FusedElementwiseBuilder("fused-elementwise");
+
+}  // namespace multio::action
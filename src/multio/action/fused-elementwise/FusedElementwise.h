@@ -0,0 +1,48 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "multio/action/ChainedAction.h"
+#include "multio/action/ElementwiseStage.h"
+
+namespace multio::action {
+
+/**
+ * Runs several elementwise stages (e.g. mask, scale, convert-precision) in a single pass over the payload.
+ * The payload is traversed block by block and every stage is applied to a block while it is still in cache.
+ * Metadata is only copied once per message, and a precision conversion writes directly into the output buffer.
+ *
+ * Usually created by the plan for consecutive fusible actions (option "fuse-elementwise-actions"), but it can also be
+ * configured directly:
+ *
+ *   - type: fused-elementwise
+ *     stages:
+ *       - type: mask
+ *       - type: scale
+ *         mapping-definition: ...
+ */
+class FusedElementwise final : public ChainedAction {
+public:
+    explicit FusedElementwise(const ComponentConfiguration& compConf);
+
+    void executeImpl(message::Message msg) override;
+
+private:
+    void print(std::ostream& os) const override;
+
+    std::vector<std::unique_ptr<ElementwiseStage>> stages_;
+};
+
+}  // namespace multio::action
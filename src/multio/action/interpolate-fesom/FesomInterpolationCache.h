@@ -0,0 +1,208 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "InterpolateFesom_debug.h"
+#include "eckit/exception/Exceptions.h"
+#include "multio/LibMultio.h"
+
+namespace multio::action::interpolateFESOM {
+
+/**
+ * \class Bounded cache of interpolation matrices, keyed by cache name (one entry per level).
+ *
+ * Entries are loaded on demand through the loader passed to the constructor, or ahead of time from a background
+ * thread (see `prefetch`). A key that is currently being loaded is never loaded twice: concurrent requests wait on
+ * the same shared future. When a memory budget is set, the least recently used entries are evicted once the budget
+ * is exceeded. Evicted matrices stay alive as long as an interpolation still holds a reference to them.
+ */
+template <typename Interpolator>
+class FesomInterpolationCache {
+public:
+    using Pointer = std::shared_ptr<const Interpolator>;
+    using Loader = std::function<std::unique_ptr<Interpolator>(const std::string&)>;
+
+    /// @param maxMemory Memory budget in bytes, 0 means unbounded
+    FesomInterpolationCache(Loader loader, size_t maxMemory) : loader_{std::move(loader)}, maxMemory_{maxMemory} {}
+
+    ~FesomInterpolationCache() {
+        stopPrefetch_ = true;
+        if (prefetchThread_.joinable()) {
+            prefetchThread_.join();
+        }
+    }
+
+    FesomInterpolationCache(const FesomInterpolationCache&) = delete;
+    FesomInterpolationCache& operator=(const FesomInterpolationCache&) = delete;
+
+    /// Returns the interpolator for the key, loading it synchronously if it is neither cached nor being prefetched
+    Pointer get(const std::string& key) {
+        std::shared_future<Pointer> future;
+        std::promise<Pointer> promise;
+        bool mustLoad = false;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto search = entries_.find(key);
+            if (search != entries_.end()) {
+                touch(search->second);
+                future = search->second.value;
+            }
+            else {
+                future = insertPending(key, promise);
+                mustLoad = true;
+            }
+        }
+        if (mustLoad) {
+            INTERPOLATE_FESOM_OUT_STREAM << " - FesomInterpolationCache: cache miss for " << key << std::endl;
+            load(key, promise);
+        }
+        return future.get();
+    }
+
+    /// Loads the given keys on a background thread. Stops early once the memory budget is filled so that prefetched
+    /// entries do not evict each other.
+    void prefetch(std::vector<std::string> keys) {
+        ASSERT(!prefetchThread_.joinable());
+        prefetchThread_ = std::thread([this, keys = std::move(keys)]() {
+            for (const auto& key : keys) {
+                if (stopPrefetch_) {
+                    return;
+                }
+                std::promise<Pointer> promise;
+                {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    if ((maxMemory_ > 0) && (usedMemory_ >= maxMemory_)) {
+                        INTERPOLATE_FESOM_OUT_STREAM << " - FesomInterpolationCache: memory budget reached, "
+                                                     << "prefetching stopped before " << key << std::endl;
+                        return;
+                    }
+                    if (entries_.find(key) != entries_.end()) {
+                        continue;
+                    }
+                    insertPending(key, promise);
+                }
+                INTERPOLATE_FESOM_OUT_STREAM << " - FesomInterpolationCache: prefetching " << key << std::endl;
+                try {
+                    load(key, promise);
+                }
+                catch (...) {
+                    // Requests already waiting on this key receive the error through the future. The entry has been
+                    // dropped, so a later request retries loading and reports the error on the dispatcher thread.
+                }
+            }
+        });
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return entries_.size();
+    }
+
+    size_t usedMemory() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return usedMemory_;
+    }
+
+private:
+    struct Entry {
+        std::shared_future<Pointer> value;
+        typename std::list<std::string>::iterator lruPosition;
+        size_t memory = 0;
+        bool ready = false;
+    };
+
+    std::shared_future<Pointer> insertPending(const std::string& key, std::promise<Pointer>& promise) {
+        lru_.push_front(key);
+        Entry entry;
+        entry.value = promise.get_future().share();
+        entry.lruPosition = lru_.begin();
+        return entries_.emplace(key, std::move(entry)).first->second.value;
+    }
+
+    void touch(Entry& entry) { lru_.splice(lru_.begin(), lru_, entry.lruPosition); }
+
+    void load(const std::string& key, std::promise<Pointer>& promise) {
+        Pointer value;
+        try {
+            value = loader_(key);
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock{mutex_};
+            erase(key);
+            throw;
+        }
+        promise.set_value(value);
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto search = entries_.find(key);
+        ASSERT(search != entries_.end());
+        search->second.ready = true;
+        search->second.memory = value->memoryFootprint();
+        usedMemory_ += search->second.memory;
+        evict(key);
+    }
+
+    void erase(const std::string& key) {
+        auto search = entries_.find(key);
+        if (search != entries_.end()) {
+            usedMemory_ -= search->second.memory;
+            lru_.erase(search->second.lruPosition);
+            entries_.erase(search);
+        }
+    }
+
+    /// Drop least recently used entries until the budget is met. Pending loads and the entry just loaded are kept.
+    void evict(const std::string& keep) {
+        if (maxMemory_ == 0) {
+            return;
+        }
+        auto it = lru_.end();
+        while ((usedMemory_ > maxMemory_) && (it != lru_.begin())) {
+            --it;
+            auto search = entries_.find(*it);
+            if ((*it == keep) || !search->second.ready) {
+                continue;
+            }
+            INTERPOLATE_FESOM_OUT_STREAM << " - FesomInterpolationCache: evicting " << *it << std::endl;
+            usedMemory_ -= search->second.memory;
+            it = lru_.erase(it);
+            entries_.erase(search);
+        }
+    }
+
+    const Loader loader_;
+    const size_t maxMemory_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::list<std::string> lru_;
+    size_t usedMemory_ = 0;
+
+    std::atomic<bool> stopPrefetch_{false};
+    std::thread prefetchThread_;
+};
+
+}  // namespace multio::action::interpolateFESOM
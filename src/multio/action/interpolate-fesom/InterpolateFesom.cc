@@ -12,12 +12,14 @@
 
 #include "multio/action/interpolate-fesom/InterpolateFesom.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "eckit/config/LocalConfiguration.h"
 #include "eckit/exception/Exceptions.h"
 
 
@@ -90,7 +92,9 @@ InterpolateFesom<T>::InterpolateFesom(const ComponentConfiguration& compConf) :
         orderingConvention_string2enum(compConf.parsedConfig().getString("ordering-convention", "ring"))},
     missingValue_{static_cast<T>(compConf.parsedConfig().getDouble("missing-value"))},
     outputPrecision_{compConf.parsedConfig().getString("output-precision", "from-message")},
-    cachePath_{fullFileName(compConf.parsedConfig().getString("cache-path", "."))} {
+    cachePath_{fullFileName(compConf.parsedConfig().getString("cache-path", "."))},
+    Interpolators_{[this](const std::string& key) { return loadInterpolator(key); },
+                   static_cast<size_t>(compConf.parsedConfig().getLong("cache-max-memory-mb", 0)) * 1024 * 1024} {
     INTERPOLATE_FESOM_OUT_STREAM << " - InterpolateFesom :: enter constructor" << std::endl;
     if (outputPrecision_ != "single" && outputPrecision_ != "double" && outputPrecision_ != "from-message") {
         std::ostringstream os;
@@ -99,6 +103,9 @@ InterpolateFesom<T>::InterpolateFesom(const ComponentConfiguration& compConf) :
            << ", got: " << outputPrecision_ << std::endl;
         throw eckit::UserError(os.str(), Here());
     }
+    if (compConf.parsedConfig().has("prefetch")) {
+        Interpolators_.prefetch(prefetchKeys(compConf.parsedConfig().getSubConfiguration("prefetch")));
+    }
     INTERPOLATE_FESOM_OUT_STREAM << " - InterpolateFesom :: exit constructor" << std::endl;
 };
 
@@ -142,6 +149,63 @@ std::string InterpolateFesom<T>::generateKey(const message::Message& msg) const
 }
 
 
+template <typename T>
+std::unique_ptr<Fesom2HEALPix<T>> InterpolateFesom<T>::loadInterpolator(const std::string& key) const {
+    // Same naming as Fesom2HEALPix::generateCacheFileName, the key already contains grid, domain, level, ...
+    std::string fname = cachePath_ + "/" + key + ".atlas";
+    if (!eckit::PathName{fname}.exists()) {
+        throw eckit::SeriousBug("Unable to open file: " + fname, Here());
+    }
+    return std::make_unique<Fesom2HEALPix<T>>(fname);
+}
+
+
+template <typename T>
+std::vector<std::string> InterpolateFesom<T>::prefetchKeys(const eckit::LocalConfiguration& cfg) const {
+    INTERPOLATE_FESOM_OUT_STREAM << " - InterpolateFesom :: enter prefetchKeys" << std::endl;
+    // Prefetching has to happen before any message is seen, hence grid name and domain are taken from the
+    // configuration instead of the message metadata ("unstructuredGridType" and "domain")
+    const std::string fesomGridName = cfg.getString("grid");
+    const std::vector<std::string> domains = cfg.has("domains") ? cfg.getStringVector("domains")
+                                                                : std::vector<std::string>{cfg.getString("domain")};
+    const std::string precision = (sizeof(T) == 4 ? "single" : "double");
+
+    std::vector<std::string> keys;
+    for (const auto& domain : domains) {
+        if (cfg.has("levels")) {
+            // Levels are the cache levels, i.e. 0-based also for ocean-3d fields on "level" type
+            for (auto level : cfg.getLongVector("levels")) {
+                keys.push_back(fesomCacheName(fesomGridName, domain, precision, NSide_, orderingConvention_, level));
+            }
+        }
+        else {
+            // Prefetch all levels found in the cache path. The level is the trailing part of the name, hence the
+            // prefix is computed from level 0 and sorting the names gives ascending levels.
+            std::string prefix = fesomCacheName(fesomGridName, domain, precision, NSide_, orderingConvention_, 0);
+            prefix.erase(prefix.rfind('_') + 1);
+
+            std::vector<eckit::PathName> files;
+            std::vector<eckit::PathName> dirs;
+            eckit::PathName{cachePath_}.children(files, dirs);
+
+            std::vector<std::string> found;
+            for (const auto& file : files) {
+                std::string name = file.baseName(false);
+                if (name.rfind(prefix, 0) == 0 && file.extension() == ".atlas") {
+                    found.push_back(std::move(name));
+                }
+            }
+            std::sort(found.begin(), found.end());
+            keys.insert(keys.end(), found.begin(), found.end());
+        }
+    }
+
+    INTERPOLATE_FESOM_OUT_STREAM << " - InterpolateFesom :: prefetching " << keys.size() << " caches" << std::endl;
+    INTERPOLATE_FESOM_OUT_STREAM << " - InterpolateFesom :: exit prefetchKeys" << std::endl;
+    return keys;
+}
+
+
 template <typename T>
 void InterpolateFesom<T>::executeImpl(message::Message msg) {
     INTERPOLATE_FESOM_OUT_STREAM
@@ -158,12 +222,8 @@ void InterpolateFesom<T>::executeImpl(message::Message msg) {
         return;
     }
 
-    std::string key = generateKey(msg);
-    if (Interpolators_.find(key) == Interpolators_.end()) {
-        // no need to check for grid type since it is already checked in the generateKey function
-        Interpolators_[key] = std::make_unique<Fesom2HEALPix<T>>(
-            msg, cachePath_, msg.metadata().get<std::string>("unstructuredGridType"), NSide_, orderingConvention_);
-    }
+    // no need to check for grid type since it is already checked in the generateKey function
+    const auto interpolator = Interpolators_.get(generateKey(msg));
 
     executeNext(util::dispatchPrecisionTag(msg.precision(), [&](auto in_pt) -> message::Message {
         util::PrecisionTag opt
@@ -177,8 +237,8 @@ void InterpolateFesom<T>::executeImpl(message::Message msg) {
             size_t outputSize = 12 * NSide_ * NSide_;
             outData.resize(outputSize);
             const InputPrecision* val = static_cast<const InputPrecision*>(msg.payload().data());
-            Interpolators_.at(key)->interpolate(val, outData.data(), inputSize, outputSize,
-                                                static_cast<OutputPrecision>(missingValue_));
+            interpolator->interpolate(val, outData.data(), inputSize, outputSize,
+                                      static_cast<OutputPrecision>(missingValue_));
             eckit::Buffer buffer(reinterpret_cast<const char*>(outData.data()),
                                  outData.size() * sizeof(OutputPrecision));
             fill_metadata(msg.metadata(), md, NSide_, orderingConvention_, outData.size(), opt, missingValue_);
@@ -190,9 +250,10 @@ void InterpolateFesom<T>::executeImpl(message::Message msg) {
                                             "============================== "
                                          << std::endl;
             INTERPOLATE_FESOM_OUT_STREAM << std::endl << std::endl;
-            return {
-                message::Message::Header{message::Message::Tag::Field, msg.source(), msg.destination(), std::move(md)},
-                std::move(buffer)};
+            message::Message::Header header{message::Message::Tag::Field, msg.source(), msg.destination(),
+                                            std::move(md)};
+            header.setOrigin(msg.origin());
+            return message::Message{std::move(header), std::move(buffer)};
         });
     }));
 }
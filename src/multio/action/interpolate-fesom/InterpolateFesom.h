@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "FesomInterpolationCache.h"
 #include "FesomInterpolationWeights.h"
 #include "InterpolateFesom_debug.h"
 #include "atlas_io/atlas-io.h"
@@ -168,9 +169,15 @@ public:
     size_t nCols() const { return nCols_; };
     size_t nOutRows() const { return nOutRows_; };
 
+    size_t memoryFootprint() const {
+        return sizeof(*this)
+             + (landSeaMask_.capacity() + rowStart_.capacity() + colIdx_.capacity()) * sizeof(std::int32_t)
+             + values_.capacity() * sizeof(MatrixType);
+    };
+
     template <typename InFieldType, typename OutFieldType>
     void interpolate(const InFieldType* fesomField, OutFieldType* HEALPixField, size_t inputSize, size_t outputSize,
-                     OutFieldType missingValue) {
+                     OutFieldType missingValue) const {
         INTERPOLATE_FESOM_OUT_STREAM << " - Fesom2HEALPix: enter intrpolate" << std::endl;
 
         if (outputSize != nOutRows_) {
@@ -269,6 +276,8 @@ private:
     void print(std::ostream&) const override;
     void executeImpl(message::Message) override;
     std::string generateKey(const message::Message& msg) const;
+    std::unique_ptr<Fesom2HEALPix<T>> loadInterpolator(const std::string& key) const;
+    std::vector<std::string> prefetchKeys(const eckit::LocalConfiguration& cfg) const;
 
     // Fesom interpolators with at different levels (different LSM)
     const size_t NSide_;
@@ -280,7 +289,8 @@ private:
     // const std::string fesomGridName_;
     // FesomInterpolationWeights cacheGenerator_;
 
-    std::map<std::string, std::unique_ptr<Fesom2HEALPix<T>>> Interpolators_;
+    // Loaded on demand or prefetched in the background, bounded by "cache-max-memory-mb"
+    FesomInterpolationCache<Fesom2HEALPix<T>> Interpolators_;
 };
 
 
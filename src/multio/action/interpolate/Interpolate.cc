@@ -500,8 +500,9 @@ message::Message Interpolate::InterpolateMessage<double>(message::Message&& msg)
                              << std::endl;
 
 
-    return {message::Message::Header{message::Message::Tag::Field, msg.source(), msg.destination(), std::move(md)},
-            std::move(buffer)};
+    message::Message::Header header{message::Message::Tag::Field, msg.source(), msg.destination(), std::move(md)};
+    header.setOrigin(msg.origin());
+    return {std::move(header), std::move(buffer)};
 }
 
 template <>
@@ -10,13 +10,15 @@
 
 #include "Mask.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "eckit/config/Configuration.h"
 #include "eckit/exception/Exceptions.h"
 #include "eckit/log/Log.h"
 
 #include "multio/domain/Mask.h"
-
-#include "multio/util/PrecisionTag.h"
+#include "multio/message/Glossary.h"
 
 namespace multio::action {
 
@@ -31,109 +33,117 @@ bool setContains(const std::set<Precision>& _set, const Precision& key) {
     return _set.find(key) != std::end(_set);
 }
 
-}  // namespace
-
-Mask::Mask(const ComponentConfiguration& compConf) :
-    ChainedAction(compConf),
-    applyBitmap_{compConf.parsedConfig().getBool("apply-bitmap", true)},
-    missingValue_{compConf.parsedConfig().getDouble("missing-value", std::numeric_limits<float>::max())},
-    offsetFields_{fetch_offset_fields(compConf.parsedConfig())},
-    offsetValue_{compConf.parsedConfig().getDouble("offset-value", 273.15)} {}
 
-void Mask::executeImpl(message::Message msg) {
-    if (msg.tag() != message::Message::Tag::Field) {
-        executeNext(std::move(msg));
-        return;
+// Walks the decoded runs alongside the blocks: masked gaps are filled with the missing value, valid runs get the
+// offset. Mask, offset and missing value substitution thus happen in a single pass.
+class MaskKernel final : public ElementwiseKernelBase<MaskKernel> {
+public:
+    MaskKernel(std::shared_ptr<const domain::MaskRuns> runs, bool applyBitmap, double missingValue, bool withOffset,
+               double offsetValue) :
+        runs_{std::move(runs)},
+        applyBitmap_{applyBitmap},
+        missingValue_{missingValue},
+        withOffset_{withOffset},
+        offsetValue_{offsetValue} {}
+
+    void updateMetadata(message::Metadata& md) const override {
+        md.set("missingValue", missingValue_);
+        md.set("bitmapPresent", true);
     }
 
-    executeNext(dispatchPrecisionTag(msg.precision(), [&](auto pt) {
-        using Precision = typename decltype(pt)::type;
-        return createMasked<Precision>(std::move(msg));
-    }));
-}
-
+    bool modifiesPayload() const override { return applyBitmap_ || withOffset_; }
 
-template <typename Precision>
-message::Message Mask::createMasked(message::Message msg) const {
-    util::ScopedTiming timing{statistics_.actionTiming_};
+    template <typename Precision>
+    void applyImpl(Precision* block, std::size_t begin, std::size_t end) {
+        const auto& valid = runs_->valid;
+        const auto missingValue = static_cast<Precision>(missingValue_);
+        const auto offsetValue = static_cast<Precision>(offsetValue_);
 
-    msg.acquire();
-    // Now metadata and payload can be modified
+        std::size_t pos = begin;
+        while (pos < end) {
+            while ((run_ < valid.size()) && (valid[run_].second <= pos)) {
+                ++run_;
+            }
+            const std::size_t first = (run_ < valid.size()) ? std::min(std::max(valid[run_].first, pos), end) : end;
+            const std::size_t last = (run_ < valid.size()) ? std::min(valid[run_].second, end) : end;
 
-    if (applyBitmap_) {
-        applyMask<Precision>(msg);
+            if (applyBitmap_) {
+                std::fill(block + (pos - begin), block + (first - begin), missingValue);
+            }
+            if (withOffset_) {
+                for (std::size_t i = first - begin; i < last - begin; ++i) {
+                    block[i] += offsetValue;
+                }
+            }
+            pos = last;
+        }
     }
 
-    if (setContains(offsetFields_, msg.name())) {
-        applyOffset<Precision>(msg);
-    }
+private:
+    std::shared_ptr<const domain::MaskRuns> runs_;
+    bool applyBitmap_;
+    double missingValue_;
+    bool withOffset_;
+    double offsetValue_;
 
-    message::Metadata& md = msg.modifyMetadata();
-    md.set("missingValue", missingValue_);
-    md.set("bitmapPresent", true);
+    std::size_t run_ = 0;  // First run that may overlap with the next block
+};
 
-    return msg;
-}
+}  // namespace
 
 
-template <typename Precision>
-void Mask::applyMask(message::Message& msg) const {
-    auto const& bkey = domain::Mask::key(msg.metadata());
-    auto const& bitmask = domain::Mask::instance().get(bkey);
-
-    if (bitmask.size() * sizeof(Precision) != msg.size()) {
-        std::ostringstream oss;
-        oss << "Mask::applyMask: Mask for key \"" << bkey << "\" has a size of " << bitmask.size()
-            << " but the message contains " << (msg.size() / sizeof(Precision)) << " values. " << std::endl;
-        throw eckit::SeriousBug(oss.str(), Here());
-    }
+MaskStage::MaskStage(const ComponentConfiguration& compConf) :
+    applyBitmap_{compConf.parsedConfig().getBool("apply-bitmap", true)},
+    missingValue_{compConf.parsedConfig().getDouble("missing-value", std::numeric_limits<float>::max())},
+    offsetFields_{fetch_offset_fields(compConf.parsedConfig())},
+    offsetValue_{compConf.parsedConfig().getDouble("offset-value", 273.15)} {}
 
-    auto git = static_cast<Precision*>(msg.payload().modifyData());
+std::unique_ptr<ElementwiseKernel> MaskStage::prepare(const message::Metadata& md, std::size_t size) const {
+    const bool withOffset = setContains(offsetFields_, md.get<std::string>(message::glossary().name));
 
-    std::size_t offset = 0;
-    for (const auto& valLengthPair : bitmask) {
-        if (valLengthPair.first) {
-            offset += valLengthPair.second;
-        }
-        else {
-            std::size_t nextOffset = offset + valLengthPair.second;
-            for (std::size_t i = offset; i < nextOffset; ++i) {
-                git[i] = static_cast<Precision>(missingValue_);
-            }
-            offset = nextOffset;
+    std::shared_ptr<const domain::MaskRuns> runs;
+    if (applyBitmap_ || withOffset) {
+        auto const& bkey = domain::Mask::key(md);
+        runs = domain::Mask::instance().getRuns(bkey);
+
+        if (runs->size != size) {
+            std::ostringstream oss;
+            oss << "Mask: Mask for key \"" << bkey << "\" has a size of " << runs->size
+                << " but the message contains " << size << " values. " << std::endl;
+            throw eckit::SeriousBug(oss.str(), Here());
         }
     }
+
+    return std::make_unique<MaskKernel>(std::move(runs), applyBitmap_, missingValue_, withOffset, offsetValue_);
 }
 
-template <typename Precision>
-void Mask::applyOffset(message::Message& msg) const {
-    auto const& bkey = domain::Mask::key(msg.metadata());
-    auto const& bitmask = domain::Mask::instance().get(bkey);
+void MaskStage::print(std::ostream& os) const {
+    os << "Mask(missing=" << missingValue_ << ", offset-fields=" << offsetFields_ << ", offset-value=" << offsetValue_
+       << ")";
+}
 
-    ASSERT(bitmask.size() == msg.size() / sizeof(Precision));
 
-    auto git = static_cast<Precision*>(msg.payload().modifyData());
+Mask::Mask(const ComponentConfiguration& compConf) : ChainedAction(compConf), stage_{compConf} {}
 
-    std::size_t offset = 0;
-    for (const auto& valLengthPair : bitmask) {
-        if (valLengthPair.first) {
-            std::size_t nextOffset = offset + valLengthPair.second;
-            for (std::size_t i = offset; i < nextOffset; ++i) {
-                git[i] = git[i] + static_cast<Precision>(offsetValue_);
-            }
-            offset = nextOffset;
-        }
-        else {
-            offset += valLengthPair.second;
-        }
+void Mask::executeImpl(message::Message msg) {
+    if (msg.tag() != message::Message::Tag::Field) {
+        executeNext(std::move(msg));
+        return;
+    }
+
+    {
+        util::ScopedTiming timing{statistics_.actionTiming_};
+        applyInPlace(*stage_.prepare(msg.metadata(), payloadValues(msg)), msg);
     }
+
+    executeNext(std::move(msg));
 }
 
 void Mask::print(std::ostream& os) const {
-    os << "Mask(missing=" << missingValue_ << ", offset-fields=" << offsetFields_ << ", offset-value=" << offsetValue_
-       << ")";
+    os << stage_;
 }
 
 static ActionBuilder<Mask> MaskBuilder("mask");
+static ElementwiseStageBuilder<MaskStage> MaskStageBuilder("mask");
 
 }  // namespace multio::action
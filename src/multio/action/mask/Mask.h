@@ -19,28 +19,21 @@
 #include <iosfwd>
 
 #include "multio/action/ChainedAction.h"
+#include "multio/action/ElementwiseStage.h"
 #include "multio/domain/Domain.h"
 #include "multio/domain/Mask.h"
 
 namespace multio::action {
 
 
-class Mask : public ChainedAction {
+// Masking and offsetting as elementwise stage, shared by the Mask action and fused elementwise pipelines
+class MaskStage final : public ElementwiseStage {
 public:
-    explicit Mask(const ComponentConfiguration& compConf);
+    explicit MaskStage(const ComponentConfiguration& compConf);
 
-    void executeImpl(message::Message msg) override;
+    std::unique_ptr<ElementwiseKernel> prepare(const message::Metadata& md, std::size_t size) const override;
 
 private:
-    template <typename Precision>
-    message::Message createMasked(message::Message msg) const;
-
-    template <typename Precision>
-    void applyMask(message::Message& msg) const;
-
-    template <typename Precision>
-    void applyOffset(message::Message& msg) const;
-
     void print(std::ostream& os) const override;
 
     bool applyBitmap_;
@@ -49,4 +42,17 @@ private:
     double offsetValue_;
 };
 
+
+class Mask : public ChainedAction {
+public:
+    explicit Mask(const ComponentConfiguration& compConf);
+
+    void executeImpl(message::Message msg) override;
+
+private:
+    void print(std::ostream& os) const override;
+
+    MaskStage stage_;
+};
+
 }  // namespace multio::action
@@ -9,6 +9,7 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 
@@ -147,11 +148,8 @@ void CacheGenerator::execute(const eckit::option::CmdArgs& args) {
     // for ( size_t i=from_; i<=to_; ++i ){
     for (size_t i = 0; i < list_.size(); ++i) {
         size_t Nside = ref << list_[i];
-        HEALPix Idx(static_cast<int>(Nside));
-        std::vector<size_t> map(Nside * Nside * 12, 0);
-        for (size_t j = 0; j < Nside * Nside * 12; ++j) {
-            map[j] = static_cast<size_t>(Idx.ring_to_nest(static_cast<int>(j)));
-        }
+        const auto ring2nest = HEALPix(static_cast<int>(Nside)).ring_to_nest_map(std::thread::hardware_concurrency());
+        std::vector<size_t> map(ring2nest.begin(), ring2nest.end());
         std::ostringstream os;
         os << "H" << std::setfill('0') << std::setw(8) << Nside << "_ring2nest";
         record.set(os.str(), map);
@@ -14,11 +14,13 @@
 
 #include "HEALPix.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <thread>
 #include <tuple>
 
 namespace {
@@ -196,3 +198,82 @@ int HEALPix::nest_to_ring(int n) const {
 
     return r0 + to_ring_local(f, i, j, Nring, 0);
 }
+
+
+void HEALPix::fill_ring_to_nest(int* map, int ringBegin, int ringEnd, int ringStride) const {
+    // Same relations as nest_to_ring, inverted ring by ring: on ring R the pixels of face f satisfy
+    // i + j = s = ((f >> 2) + 2) * Nside - R - 1 and are contiguous in ring ordering for increasing i.
+    for (int ring = ringBegin; ring < ringEnd; ring += ringStride) {
+        int Nring4;  // (number of pixels in ring) / 4
+        int r0;      // index of first ring pixel (ring numbering)
+        int shift;   // if ring's first pixel is/is not at phi=0
+        if (ring < Nside_) {
+            // North polar cap
+            Nring4 = ring;
+            r0 = 2 * ring * (ring - 1);
+            shift = 0;
+        }
+        else if (ring < 3 * Nside_) {
+            // Equatorial belt
+            Nring4 = Nside_;
+            r0 = Ncap_ + (ring - Nside_) * 4 * Nside_;
+            shift = (ring - Nside_) & 1;
+        }
+        else {
+            // South polar cap
+            Nring4 = 4 * Nside_ - ring;
+            r0 = Npix_ - 2 * Nring4 * (Nring4 + 1);
+            shift = 0;
+        }
+
+        for (int f = 0; f < 12; ++f) {
+            const int s = ((f >> 2) + 2) * Nside_ - ring - 1;
+            if (s < 0 || s > 2 * (Nside_ - 1)) {
+                continue;
+            }
+            const int iBegin = (s >= Nside_) ? s - Nside_ + 1 : 0;
+            const int iEnd = (s < Nside_) ? s + 1 : Nside_;
+            const int a = pll(f) * Nring4 - s + 1 + shift;
+            const int fNest = f << (2 * k_);
+
+            // Branch-free body, suitable for vectorisation
+            for (int i = iBegin; i < iEnd; ++i) {
+                int r = (a + 2 * i) / 2 - 1;
+                r += (r < 0) ? 4 * Nside_ : 0;
+                map[r0 + r] = fNest + CodecFijNest::nest_encode_bits(i) + (CodecFijNest::nest_encode_bits(s - i) << 1);
+            }
+        }
+    }
+}
+
+
+std::vector<int> HEALPix::ring_to_nest_map(std::size_t nThreads) const {
+    std::vector<int> map(Npix_);
+
+    // Rings 1 ... 4 * Nside - 1 are interleaved over the threads to balance short polar and long equatorial rings
+    const int nRings = 4 * Nside_ - 1;
+    const int stride = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(nThreads, nRings)));
+    std::vector<std::thread> threads;
+    for (int t = 1; t < stride; ++t) {
+        threads.emplace_back(
+            [this, &map, t, stride, nRings]() { fill_ring_to_nest(map.data(), 1 + t, nRings + 1, stride); });
+    }
+    fill_ring_to_nest(map.data(), 1, nRings + 1, stride);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return map;
+}
+
+
+std::vector<int> HEALPix::nest_to_ring_map(std::size_t nThreads) const {
+    const auto ring2nest = ring_to_nest_map(nThreads);
+
+    std::vector<int> map(Npix_);
+    for (int r = 0; r < Npix_; ++r) {
+        map[ring2nest[r]] = r;
+    }
+
+    return map;
+}
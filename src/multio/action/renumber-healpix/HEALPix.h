@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <thread>
+#include <vector>
+
 class HEALPix {
 public:
     explicit HEALPix(int Nside);
@@ -24,9 +28,52 @@ public:
     int nest_to_ring(int) const;
     int ring_to_nest(int) const;
 
+    // Bulk renumbering of all pixels, map[ring] = nest (resp. map[nest] = ring). Rings are distributed over nThreads
+    // threads and filled contiguously, which is considerably faster than calling ring_to_nest per pixel.
+    std::vector<int> ring_to_nest_map(std::size_t nThreads = 1) const;
+    std::vector<int> nest_to_ring_map(std::size_t nThreads = 1) const;
+
 private:
+    void fill_ring_to_nest(int* map, int ringBegin, int ringEnd, int ringStride) const;
+
     const int Nside_;  // up to 2^13
     const int Npix_;
     const int Ncap_;
     const int k_;
 };
+
+
+// Gathers in[map[i]] into out[i], e.g. with map = nest_to_ring_map() a field in ring ordering is renumbered to nested
+// ordering. Output is written sequentially in blocks, the nested ordering keeps the reads of a block local.
+template <typename T>
+void healpix_permute(const T* in, T* out, const std::vector<int>& map, std::size_t nThreads = 1) {
+    constexpr std::size_t blockSize = 4096;
+    const std::size_t size = map.size();
+    const std::size_t nBlocks = (size + blockSize - 1) / blockSize;
+
+    auto permuteBlocks = [&](std::size_t first, std::size_t stride) {
+        for (std::size_t block = first; block < nBlocks; block += stride) {
+            const std::size_t begin = block * blockSize;
+            const std::size_t end = (begin + blockSize < size) ? begin + blockSize : size;
+            const int* idx = map.data();
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = in[idx[i]];
+            }
+        }
+    };
+
+    if (nThreads <= 1 || nBlocks <= 1) {
+        permuteBlocks(0, 1);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (std::size_t t = 1; t < nThreads; ++t) {
+        threads.emplace_back(permuteBlocks, t, nThreads);
+    }
+    permuteBlocks(0, nThreads);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
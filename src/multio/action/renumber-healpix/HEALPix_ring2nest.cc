@@ -34,12 +34,10 @@ namespace multio::action {
 namespace {
 std::string parseCacheFileName(const ComponentConfiguration& compConf) {
 
-    // Check necessary options
+    // Without cache file the mapping is computed in memory
     const auto cfg = compConf.parsedConfig();
     if (!cfg.has("cache-file-name")) {
-        std::ostringstream oss;
-        oss << "HEALPix_ring2nest: expected \"cache-file-name\" option" << std::endl;
-        throw eckit::UserError(oss.str(), Here());
+        return "";
     }
 
     // Expand file name
@@ -93,7 +91,7 @@ void checkMetadata(const message::Metadata& md) {
     }
 }
 
-std::vector<size_t> makeMapping(size_t Nside, const std::string& cacheFileName) {
+std::vector<int> readMapping(size_t Nside, const std::string& cacheFileName) {
     std::vector<size_t> map;
     atlas::io::RecordReader reader(cacheFileName);
     std::ostringstream os;
@@ -104,13 +102,34 @@ std::vector<size_t> makeMapping(size_t Nside, const std::string& cacheFileName)
         oss << "HEALPix_ring2nest: expected map size : " << 12 * Nside * Nside << ", got: " << map.size() << std::endl;
         throw eckit::UserError(oss.str(), Here());
     }
-    return map;
+
+    // The cache stores map[ring] = nest, invert to gather in nested order
+    std::vector<int> gather(map.size());
+    for (size_t r = 0; r < map.size(); ++r) {
+        gather[map[r]] = static_cast<int>(r);
+    }
+    return gather;
 }
 }  // namespace
 
 
 HEALPixRingToNest::HEALPixRingToNest(const ComponentConfiguration& compConf) :
-    ChainedAction(compConf), cacheFileName_{parseCacheFileName(compConf)} {}
+    ChainedAction(compConf),
+    cacheFileName_{parseCacheFileName(compConf)},
+    threads_{static_cast<size_t>(compConf.parsedConfig().getUnsigned("threads", 1))} {}
+
+
+std::vector<int> HEALPixRingToNest::makeMapping(size_t Nside) const {
+    if (!cacheFileName_.empty()) {
+        return readMapping(Nside, cacheFileName_);
+    }
+    if ((Nside == 0) || ((Nside & (Nside - 1)) != 0)) {
+        std::ostringstream oss;
+        oss << "HEALPix_ring2nest: nested ordering requires \"Nside\" to be a power of 2, got: " << Nside << std::endl;
+        throw eckit::UserError(oss.str(), Here());
+    }
+    return HEALPix(static_cast<int>(Nside)).nest_to_ring_map(threads_);
+}
 
 
 void HEALPixRingToNest::executeImpl(message::Message msg) {
@@ -126,7 +145,7 @@ void HEALPixRingToNest::executeImpl(message::Message msg) {
     // Lookup cache
     auto key = static_cast<size_t>(msg.metadata().get<std::int64_t>("Nside"));
     if (mapping_.find(key) == mapping_.end()) {
-        mapping_[key] = makeMapping(static_cast<size_t>(msg.metadata().get<std::int64_t>("Nside")), cacheFileName_);
+        mapping_[key] = makeMapping(key);
     }
     const auto& map = mapping_.at(key);
 
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <string>
 
+#include "HEALPix.h"
 #include "multio/action/ChainedAction.h"
 #include "multio/config/ComponentConfiguration.h"
 #include "multio/message/Message.h"
@@ -33,7 +34,7 @@ public:
 
 private:
     template <typename Precision>
-    message::Message applyMap(const message::Message&& msg, const std::vector<size_t>& map) const {
+    message::Message applyMap(const message::Message&& msg, const std::vector<int>& map) const {
 
         if (map.size() != msg.size() / sizeof(Precision)) {
             std::ostringstream oss;
@@ -42,24 +43,25 @@ private:
             throw eckit::SeriousBug(oss.str(), Here());
         }
 
-        std::vector<Precision> out(map.size(), 0.0);
-        auto in = reinterpret_cast<const Precision*>(msg.payload().data());
-        for (size_t i = 0; i < map.size(); ++i) {
-            out[map[i]] = in[i];
-        }
+        eckit::Buffer buffer(map.size() * sizeof(Precision));
+        healpix_permute(reinterpret_cast<const Precision*>(msg.payload().data()),
+                        static_cast<Precision*>(buffer.data()), map, threads_);
 
         message::Metadata md = msg.metadata();
         md.set("orderingConvention", "nested");
-        eckit::Buffer buffer(reinterpret_cast<const char*>(out.data()), out.size() * sizeof(Precision));
-        return message::Message{
-            message::Message::Header{message::Message::Tag::Field, msg.source(), msg.destination(), std::move(md)},
-            std::move(buffer)};
+        message::Message::Header header{message::Message::Tag::Field, msg.source(), msg.destination(), std::move(md)};
+        header.setOrigin(msg.origin());
+        return message::Message{std::move(header), std::move(buffer)};
     }
 
     void print(std::ostream& os) const override;
 
-    std::map<size_t, std::vector<size_t>> mapping_;
+    std::vector<int> makeMapping(size_t Nside) const;
+
+    // Gather maps (map[nest] = ring) per Nside
+    std::map<size_t, std::vector<int>> mapping_;
     std::string cacheFileName_;
+    size_t threads_;
 };
 
 }  // namespace multio::action
@@ -10,6 +10,8 @@
 
 #include "multio/action/scale/Scale.h"
 
+#include <algorithm>
+
 #include "eckit/exception/Exceptions.h"
 #include "eckit/log/Log.h"
 
@@ -18,7 +20,6 @@
 #include "multio/config/ComponentConfiguration.h"
 #include "multio/message/Glossary.h"
 #include "multio/message/Message.h"
-#include "multio/util/PrecisionTag.h"
 
 #include "multio/action/scale/Mapping.h"
 #include "multio/action/scale/MetadataUtils.h"
@@ -29,8 +30,30 @@ namespace multio::action {
 
 using message::glossary;
 
-Scale::Scale(const ComponentConfiguration& compConf) :
-    ChainedAction(compConf), scaling_{compConf}, mapping_{compConf}, paramsToScale_{} {
+namespace {
+
+class ScaleKernel final : public ElementwiseKernelBase<ScaleKernel> {
+public:
+    ScaleKernel(const ScaleMapping& mapping, double scaleFactor) : mapping_{mapping}, scaleFactor_{scaleFactor} {}
+
+    void updateMetadata(message::Metadata& md) const override { mapping_.applyMapping(md); }
+
+    template <typename Precision>
+    void applyImpl(Precision* block, std::size_t begin, std::size_t end) {
+        const double scaleFactor = scaleFactor_;
+        std::transform(block, block + (end - begin), block,
+                       [scaleFactor](Precision value) { return static_cast<Precision>(value * scaleFactor); });
+    }
+
+private:
+    const ScaleMapping& mapping_;
+    double scaleFactor_;
+};
+
+}  // namespace
+
+ScaleStage::ScaleStage(const ComponentConfiguration& compConf) :
+    scaling_{compConf}, mapping_{compConf}, paramsToScale_{} {
 
     const auto mappings = compConf.parsedConfig().has("mapping-definition")
                             ? compConf.parsedConfig().getSubConfigurations("mapping-definition")
@@ -44,53 +67,53 @@ Scale::Scale(const ComponentConfiguration& compConf) :
     }
 }
 
-void Scale::executeImpl(message::Message msg) {
-    if (msg.tag() != message::Message::Tag::Field) {
-        executeNext(std::move(msg));
-        return;
-    }
-
-    std::string cparam = extractParam(msg.metadata());
+std::unique_ptr<ElementwiseKernel> ScaleStage::prepare(const message::Metadata& md, std::size_t size) const {
+    std::string cparam = extractParam(md);
 
     // Continue if no scaling definition was specified in the plan.
     if (paramsToScale_.find(cparam) == paramsToScale_.end()) {
-        executeNext(std::move(msg));
-        return;
+        return nullptr;
     }
-    // Scale the message
-    util::dispatchPrecisionTag(msg.precision(), [&](auto pt) {
-        using Precision = typename decltype(pt)::type;
-        ScaleMessage<Precision>(msg);  // Modify msg in place
-    });
-    // pass on the modified message
-    executeNext(std::move(msg));
-    return;
-}
 
-template <typename Precision>
-void Scale::ScaleMessage(message::Message& msg) const {
+    if (size == 0) {
+        throw eckit::SeriousBug{" Payload is empty: Scaling Action: " + md.toString(), Here()};
+    }
 
     LOG_DEBUG_LIB(LibMultio) << "Scale :: Metadata of the input message :: Apply Scaling " << std::endl
-                             << msg.metadata() << std::endl;
-    msg.acquire();
+                             << md << std::endl;
+
+    return std::make_unique<ScaleKernel>(mapping_, scaling_.getScalingFactor(cparam));
+}
+
+void ScaleStage::print(std::ostream& os) const {
+    os << "Scale Action ";
+}
 
-    // Potentially work with msg = scaling_.applyScaling<Precision>(std::move(msg))
-    scaling_.applyScaling<Precision>(msg);
 
-    mapping_.applyMapping(msg.modifyMetadata());
+Scale::Scale(const ComponentConfiguration& compConf) : ChainedAction(compConf), stage_{compConf} {}
 
+void Scale::executeImpl(message::Message msg) {
+    if (msg.tag() != message::Message::Tag::Field) {
+        executeNext(std::move(msg));
+        return;
+    }
+
+    // Scale the message in place, if a scaling definition was specified in the plan
+    if (auto kernel = stage_.prepare(msg.metadata(), payloadValues(msg))) {
+        applyInPlace(*kernel, msg);
+    }
+
+    // pass on the modified message
+    executeNext(std::move(msg));
     return;
 }
 
 void Scale::print(std::ostream& os) const {
-    os << "Scale Action ";
+    os << stage_;
 }
 
 static ActionBuilder<Scale> ScaleBuilder("scale");
-
-
-template void Scale::ScaleMessage<float>(message::Message&) const;
-template void Scale::ScaleMessage<double>(message::Message&) const;
+static ElementwiseStageBuilder<ScaleStage> ScaleStageBuilder("scale");
 
 
 }  // namespace multio::action
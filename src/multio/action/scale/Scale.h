@@ -1,6 +1,7 @@
 #pragma once
 
 #include "multio/action/ChainedAction.h"
+#include "multio/action/ElementwiseStage.h"
 #include "multio/config/ComponentConfiguration.h"
 
 #include "multio/action/scale/Mapping.h"
@@ -8,19 +9,29 @@
 
 namespace multio::action {
 
-class Scale final : public ChainedAction {
+// Scaling and parameter remapping as elementwise stage, shared by the Scale action and fused elementwise pipelines
+class ScaleStage final : public ElementwiseStage {
 public:
-    explicit Scale(const ComponentConfiguration& compConf);  // Constructor declaration
+    explicit ScaleStage(const ComponentConfiguration& compConf);
 
-    void executeImpl(message::Message msg) override;
+    std::unique_ptr<ElementwiseKernel> prepare(const message::Metadata& md, std::size_t size) const override;
 
 private:
+    void print(std::ostream&) const override;
+
     ScaleScaling scaling_;
     ScaleMapping mapping_;
     std::set<std::string> paramsToScale_;
+};
 
-    template <typename Precision>
-    void ScaleMessage(message::Message& msg) const;
+class Scale final : public ChainedAction {
+public:
+    explicit Scale(const ComponentConfiguration& compConf);  // Constructor declaration
+
+    void executeImpl(message::Message msg) override;
+
+private:
+    ScaleStage stage_;
 
     void print(std::ostream&) const override;
 };
@@ -14,23 +14,42 @@
 #include <sstream>
 
 #include "eckit/exception/Exceptions.h"
-#include "eckit/message/Message.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/AutoClose.h"
+#include "eckit/io/DataHandle.h"
 
 #include "multio/LibMultio.h"
 #include "multio/message/Glossary.h"
 #include "multio/sink/DataSink.h"
+#include "multio/util/Hash.h"
+#include "multio/util/TraceSpan.h"
 
 namespace multio::action {
 
 using message::glossary;
 
 SingleFieldSink::SingleFieldSink(const ComponentConfiguration& compConf) :
-    Action{compConf}, rootPath_{compConf.parsedConfig().getString("root_path", "")} {}
+    Action{compConf},
+    rootPath_{compConf.parsedConfig().getString("root_path", "")},
+    maxOpenFiles_{compConf.parsedConfig().getUnsigned("max-open-files", 0)},
+    shards_{static_cast<std::uint32_t>(compConf.parsedConfig().getUnsigned("directory-shards", 0))},
+    stepContainers_{compConf.parsedConfig().getBool("step-containers", false)},
+    sinkLatency_{compConf.parsedConfig().getString("plan-name", ""), "sink"} {}
+
+SingleFieldSink::~SingleFieldSink() {
+    try {
+        writeIndices();
+    }
+    catch (const std::exception& e) {
+        eckit::Log::error() << "SingleFieldSink: writing container indices failed: " << e.what() << std::endl;
+    }
+}
 
 void SingleFieldSink::executeImpl(Message msg) {
     switch (msg.tag()) {
         case Message::Tag::Field:
             write(msg);
+            sinkLatency_.record(msg.origin().time);
             break;
 
         case Message::Tag::Flush:
@@ -44,6 +63,7 @@ void SingleFieldSink::executeImpl(Message msg) {
 
 void SingleFieldSink::write(Message msg) {
     util::ScopedTiming timing{statistics_.actionTiming_};
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_SINK_WRITE, util::traceFieldKey(msg.metadata()));
 
     std::string paramOrId;
     auto searchParam = msg.metadata().find(glossary().param);
@@ -62,42 +82,96 @@ void SingleFieldSink::write(Message msg) {
         }
     }
 
+    const auto step = msg.metadata().get<std::int64_t>("step");
 
     std::ostringstream oss;
-    oss << rootPath_ << msg.metadata().get<std::int64_t>("level") << "::" << paramOrId
-        << "::" << msg.metadata().get<std::int64_t>("step");
-    eckit::LocalConfiguration config;
+    oss << msg.metadata().get<std::int64_t>("level") << "::" << paramOrId << "::" << step;
+
+    if (!stepContainers_) {
+        open(path(oss.str())).write(msg);
+        return;
+    }
+
+    const auto container = path("step::" + std::to_string(step));
+    open(container).write(msg);
+
+    auto& size = containerSizes_[container];
+    std::ostringstream line;
+    line << oss.str() << " " << size << " " << msg.size() << "\n";
+    pendingIndices_[container] += line.str();
+    size += static_cast<std::int64_t>(msg.size());
+}
+
+std::string SingleFieldSink::path(const std::string& name) {
+    if (shards_ == 0) {
+        return rootPath_ + name;
+    }
+
+    auto dir = rootPath_ + std::to_string(util::fnv1a(name) % shards_);
+    if (createdDirs_.insert(dir).second) {
+        eckit::PathName{dir}.mkdir();
+    }
+    return dir + "/" + name;
+}
 
-    LOG_DEBUG_LIB(LibMultio) << "Writing output path: " << oss.str() << std::endl;
-    config.set("path", oss.str());
-    dataSinks_.push_back(
-        sink::DataSinkFactory::instance().build("file", ComponentConfiguration(config, compConf_.multioConfig())));
+sink::DataSink& SingleFieldSink::open(const std::string& path) {
+    auto it = openPaths_.find(path);
+    if (it != openPaths_.end()) {
+        openFiles_.splice(openFiles_.begin(), openFiles_, it->second);
+        return *openFiles_.front().sink;
+    }
 
-    eckit::message::Message blob = to_eckit_message(msg);
+    if (maxOpenFiles_ > 0 && openFiles_.size() >= maxOpenFiles_) {
+        LOG_DEBUG_LIB(LibMultio) << "Closing output path: " << openFiles_.back().path << std::endl;
+        openPaths_.erase(openFiles_.back().path);
+        openFiles_.pop_back();
+    }
 
-    dataSinks_.back()->write(blob);
+    LOG_DEBUG_LIB(LibMultio) << "Writing output path: " << path << std::endl;
+    eckit::LocalConfiguration config;
+    config.set("path", path);
+    config.set("append", createdFiles_.count(path) > 0);
+    config.set("io-uring", compConf_.parsedConfig().getBool("io-uring", false));
+    openFiles_.push_front(OpenFile{
+        path,
+        sink::DataSinkFactory::instance().build("file", ComponentConfiguration(config, compConf_.multioConfig()))});
+    openPaths_[path] = openFiles_.begin();
+    createdFiles_.insert(path);
+
+    return *openFiles_.front().sink;
 }
 
-void SingleFieldSink::flush() const {
+void SingleFieldSink::flush() {
     util::ScopedTiming timing{statistics_.actionTiming_};
 
     eckit::Log::debug<LibMultio>() << "*** Executing single-field flush for data sinks... " << std::endl;
 
-    for (const auto& sink : dataSinks_) {
-        if (sink) {
-            sink->flush();
-        }
+    for (const auto& file : openFiles_) {
+        file.sink->flush();
     }
+
+    writeIndices();
 }
 
-void SingleFieldSink::print(std::ostream& os) const {
-    for (const auto& sink : dataSinks_) {
-        if (sink) {
-            os << "Sink(DataSink=" << *sink << ")";
+void SingleFieldSink::writeIndices() {
+    for (const auto& [container, lines] : pendingIndices_) {
+        const eckit::PathName index{container + ".index"};
+        std::unique_ptr<eckit::DataHandle> handle{index.fileHandle(false)};
+        if (createdFiles_.insert(index.asString()).second) {
+            handle->openForWrite(0);
         }
         else {
-            os << "Sink(DataSink=NULL)";
+            handle->openForAppend(0);
         }
+        eckit::AutoClose closer{*handle};
+        handle->write(lines.data(), static_cast<long>(lines.size()));
+    }
+    pendingIndices_.clear();
+}
+
+void SingleFieldSink::print(std::ostream& os) const {
+    for (const auto& file : openFiles_) {
+        os << "Sink(DataSink=" << *file.sink << ")";
     }
 }
 
@@ -16,7 +16,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "multio/action/Action.h"
 
@@ -30,22 +37,61 @@ namespace action {
 
 using message::Message;
 
+/**
+ * Writes every field to its own file <root_path><level>::<param>::<step>.
+ *
+ * For runs with many fields the following options reduce the load on the file system metadata servers:
+ *  - max-open-files: keeps at most this many files open, the least recently used is closed first (default 0: no limit).
+ *    A file that is written again after being closed is reopened for appending.
+ *  - directory-shards: spreads the files over this many subdirectories <root_path><shard>/, where shard is the FNV-1a
+ *    hash of the file name modulo the number of shards (default 0: no subdirectories).
+ *  - step-containers: appends all fields of a step to one file <root_path>step::<step>. Each field is addressed by the
+ *    index file step::<step>.index, which has one line "<level>::<param>::<step> <offset> <length>" per field and is
+ *    updated on flush.
+ */
 class SingleFieldSink : public Action {
 public:
     explicit SingleFieldSink(const ComponentConfiguration& compConf);
 
+    ~SingleFieldSink() override;
+
     void executeImpl(message::Message msg) override;
 
 private:
+    struct OpenFile {
+        std::string path;
+        std::unique_ptr<sink::DataSink> sink;
+    };
+
     void print(std::ostream& os) const override;
 
     void write(Message msg);
 
-    void flush() const;
+    void flush();
 
-    std::string rootPath_;
+    void writeIndices();
+
+    std::string path(const std::string& name);
 
-    std::vector<std::unique_ptr<sink::DataSink>> dataSinks_;
+    sink::DataSink& open(const std::string& path);
+
+    std::string rootPath_;
+    std::size_t maxOpenFiles_;
+    std::uint32_t shards_;
+    bool stepContainers_;
+    util::FieldLatency sinkLatency_;
+
+    // Most recently used first
+    std::list<OpenFile> openFiles_;
+    std::unordered_map<std::string, std::list<OpenFile>::iterator> openPaths_;
+
+    // Files written before, they are reopened for appending
+    std::unordered_set<std::string> createdFiles_;
+    std::unordered_set<std::string> createdDirs_;
+
+    // Per container path: current size and index lines not written yet
+    std::unordered_map<std::string, std::int64_t> containerSizes_;
+    std::map<std::string, std::string> pendingIndices_;
 };
 
 }  // namespace action
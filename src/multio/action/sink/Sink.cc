@@ -17,16 +17,19 @@
 #include "eckit/message/Message.h"
 
 #include "multio/LibMultio.h"
+#include "multio/util/TraceSpan.h"
 
 namespace multio::action {
 
-Sink::Sink(const ComponentConfiguration& compConf) : Action(compConf), mio_{compConf} {}
+Sink::Sink(const ComponentConfiguration& compConf) :
+    Action(compConf), mio_{compConf}, sinkLatency_{compConf.parsedConfig().getString("plan-name", ""), "sink"} {}
 
 void Sink::executeImpl(Message msg) {
 
     switch (msg.tag()) {
         case Message::Tag::Field:
             write(msg);
+            sinkLatency_.record(msg.origin().time);
             return;
 
         case Message::Tag::Flush:
@@ -44,10 +47,9 @@ void Sink::executeImpl(Message msg) {
 
 void Sink::write(Message msg) {
     util::ScopedTiming timing{statistics_.actionTiming_};
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_SINK_WRITE, util::traceFieldKey(msg.metadata()));
 
-    eckit::message::Message blob = to_eckit_message(msg);
-
-    mio_.write(blob);
+    mio_.write(msg);
 }
 
 void Sink::flush() {
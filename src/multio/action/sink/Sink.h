@@ -45,6 +45,7 @@ private:
     void trigger(const Message& msg);
 
     sink::MultIO mio_;
+    util::FieldLatency sinkLatency_;
 };
 
 }  // namespace action
@@ -0,0 +1,99 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "FieldDistribution.h"
+
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "multio/message/Glossary.h"
+#include "multio/transport/Transport.h"
+#include "multio/util/ConsistentHash.h"
+#include "multio/util/PrecisionTag.h"
+#include "multio/util/VariantHelpers.h"
+
+namespace multio::action {
+
+using message::MetadataTypes;
+
+std::uint64_t fieldHash(const message::Metadata& metadata, const std::vector<MetadataTypes::KeyType>& keys) {
+    util::FieldHash hash;
+    for (const auto& key : keys) {
+        auto searchHashKey = metadata.find(key);
+        if (searchHashKey == metadata.end()) {
+            std::ostringstream os;
+            os << "The hash key \"" << key.value() << "\" is not defined in the metadata object: " << metadata
+               << std::endl;
+            throw transport::TransportException(os.str(), Here());
+        }
+
+        searchHashKey->second.visit(eckit::Overloaded{
+            [&key](const auto& v) -> util::IfTypeNotOf<decltype(v), MetadataTypes::Scalars> {
+                throw message::MetadataWrongTypeException(key.value(), Here());
+            },
+            [&hash](const auto& v) -> util::IfTypeOf<decltype(v), MetadataTypes::Scalars> {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    hash.add(v.size());
+                    hash.add(v.data(), v.size());
+                }
+                else if constexpr (std::is_arithmetic_v<T>) {
+                    hash.add(v);
+                }
+                else {
+                    hash.add('\0');
+                }
+            },
+        });
+    }
+    return hash.value();
+}
+
+std::uint64_t fieldWeight(const message::Message& msg) {
+    const auto& md = msg.metadata();
+    auto globalSize = md.getOpt<std::int64_t>(message::glossary().globalSize);
+    if (!globalSize) {
+        return 1;
+    }
+    auto precision = md.getOpt<std::string>(message::glossary().precision);
+    const std::uint64_t valueSize
+        = (precision && (util::decodePrecisionTag(*precision) == util::PrecisionTag::Float)) ? sizeof(float)
+                                                                                              : sizeof(double);
+    return static_cast<std::uint64_t>(*globalSize) * valueSize;
+}
+
+BalancedDistribution::BalancedDistribution(std::size_t serverCount, bool byBytes) :
+    byBytes_{byBytes}, loads_(serverCount) {}
+
+std::size_t BalancedDistribution::server(std::uint64_t fieldHash, const message::Message& msg) {
+    auto dest = destinations_.find(fieldHash);
+    if (dest == end(destinations_)) {
+        auto it = std::min_element(begin(loads_), end(loads_));
+        auto id = static_cast<std::size_t>(std::distance(std::begin(loads_), it));
+        dest = destinations_.emplace(fieldHash, id).first;
+        if (!byBytes_) {
+            ++loads_[id];
+        }
+    }
+
+    auto id = dest->second;
+    ASSERT(id < loads_.size());
+
+    if (byBytes_) {
+        loads_[id] += fieldWeight(msg);
+    }
+
+    return id;
+}
+
+}  // namespace multio::action
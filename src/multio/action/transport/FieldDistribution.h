@@ -0,0 +1,45 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "multio/message/Message.h"
+
+namespace multio::action {
+
+// Hash of the values of the given keys, the same on all clients. Throws if a key is missing or not a scalar
+std::uint64_t fieldHash(const message::Metadata& metadata, const std::vector<message::MetadataTypes::KeyType>& keys);
+
+// Size of the global field in bytes. All clients see the same metadata, so they all agree on the weight.
+std::uint64_t fieldWeight(const message::Message& msg);
+
+// A field stays with the server it was first sent to. New fields go to the server with the fewest fields or, by
+// bytes, with the fewest bytes sent so far.
+class BalancedDistribution {
+public:
+    BalancedDistribution(std::size_t serverCount, bool byBytes);
+
+    std::size_t server(std::uint64_t fieldHash, const message::Message& msg);
+
+    // Fields or bytes sent to each server
+    const std::vector<std::uint64_t>& loads() const { return loads_; }
+
+private:
+    const bool byBytes_;
+    std::unordered_map<std::uint64_t, std::size_t> destinations_;
+    std::vector<std::uint64_t> loads_;
+};
+
+}  // namespace multio::action
@@ -10,12 +10,13 @@
 
 #include "Transport.h"
 
-#include <algorithm>
+#include <optional>
 #include <sstream>
 
 #include "eckit/config/Resource.h"
 
 #include "multio/transport/TransportRegistry.h"
+#include "multio/util/ConsistentHash.h"
 #include "multio/util/Environment.h"
 
 namespace multio::action {
@@ -29,11 +30,12 @@ size_t serverIdDenom(size_t clientCount, size_t serverCount) {
     return (serverCount == 0) ? 1 : (((clientCount - 1) / serverCount) + 1);
 }
 
-std::vector<std::string> getHashKeys(const eckit::Configuration& conf) {
+std::vector<MetadataTypes::KeyType> getHashKeys(const eckit::Configuration& conf) {
+    std::vector<std::string> keys{"category", "name", "level"};
     if (conf.has("hash-keys")) {
-        return conf.getStringVector("hash-keys");
+        keys = conf.getStringVector("hash-keys");
     }
-    return std::vector<std::string>{"category", "name", "level"};
+    return std::vector<MetadataTypes::KeyType>(keys.begin(), keys.end());
 }
 }  // namespace
 
@@ -46,25 +48,28 @@ Transport::Transport(const ComponentConfiguration& compConf) :
     serverId_{client_.id() / serverIdDenom(transport_->serverCount(), serverCount_)},
     usedServerCount_{eckit::Resource<size_t>("multioMpiPoolSize;$MULTIO_USED_SERVERS", 1)},
     hashKeys_{getHashKeys(compConf.parsedConfig())},
-    counters_(serverPeers_.size()),
-    distType_{distributionType()} {}
+    distType_{distributionType(compConf.parsedConfig())},
+    balanced_{serverPeers_.size(), distType_ == DistributionType::even_bytes} {}
 
 void Transport::executeImpl(Message msg) {
     util::ScopedTiming timing{statistics_.actionTiming_};
 
-    auto md = msg.metadata();
-    if (md.get<bool>("toAllServers")) {
+    // The headers sent share the metadata of the message, it is only copied if anyone modifies it afterwards
+    if (msg.metadata().get<bool>("toAllServers")) {
         for (auto& server : serverPeers_) {
-            auto md = msg.metadata();
-            Message trMsg{Message::Header{msg.tag(), client_, *server, std::move(md)}, msg.payload()};
+            Message::Header header{msg.tag(), client_, *server, msg.header().moveOrCopyMetadata()};
+            header.setOrigin(msg.origin());
+            Message trMsg{std::move(header), msg.payload()};
 
             transport_->bufferedSend(trMsg);
         }
     }
     else {
-        auto server = chooseServer(msg.metadata());
+        auto server = chooseServer(msg);
 
-        Message trMsg{Message::Header{msg.tag(), client_, server, std::move(md)}, msg.payload()};
+        Message::Header header{msg.tag(), client_, server, msg.header().moveOrCopyMetadata()};
+        header.setOrigin(msg.origin());
+        Message trMsg{std::move(header), msg.payload()};
 
         transport_->bufferedSend(trMsg);
     }
@@ -74,39 +79,14 @@ void Transport::print(std::ostream& os) const {
     os << "Action[" << *transport_ << "]";
 }
 
-message::Peer Transport::chooseServer(const message::Metadata& metadata) {
+message::Peer Transport::chooseServer(const message::Message& msg) {
     ASSERT_MSG(serverCount_ > 0, "No server to choose from");
 
-    auto getMetadataValue = [&](const std::string& hashKey) -> const message::MetadataValue& {
-        auto searchHashKey = metadata.find(hashKey);
-        if (searchHashKey == metadata.end()) {
-            std::ostringstream os;
-            os << "The hash key \"" << hashKey << "\" is not defined in the metadata object: " << metadata << std::endl;
-            throw transport::TransportException(os.str(), Here());
-        }
-        return searchHashKey->second;
-    };
-
-    auto constructHash = [&]() {
-        std::ostringstream os;
-
-        for (const std::string& s : hashKeys_) {
-            getMetadataValue(s).visit(eckit::Overloaded{
-                [&s](const auto& v) -> util::IfTypeNotOf<decltype(v), MetadataTypes::Scalars> {
-                    throw message::MetadataWrongTypeException(s, Here());
-                },
-                [&os](const auto& v) -> util::IfTypeOf<decltype(v), MetadataTypes::Scalars> { os << v; },
-            });
-        }
-        return os.str();
-    };
-
     switch (distType_) {
         case DistributionType::hashed_cyclic: {
-            std::string hashString = constructHash();
             ASSERT(usedServerCount_ <= serverCount_);
 
-            auto offset = std::hash<std::string>{}(hashString) % usedServerCount_;
+            auto offset = fieldHash(msg.metadata(), hashKeys_) % usedServerCount_;
             auto id = (serverId_ + offset) % serverCount_;
 
             ASSERT(id < serverPeers_.size());
@@ -114,47 +94,50 @@ message::Peer Transport::chooseServer(const message::Metadata& metadata) {
             return *serverPeers_[id];
         }
         case DistributionType::hashed_to_single: {
-            std::string hashString = constructHash();
-            auto id = std::hash<std::string>{}(hashString) % serverCount_;
+            auto id = fieldHash(msg.metadata(), hashKeys_) % serverCount_;
 
             ASSERT(id < serverPeers_.size());
 
             return *serverPeers_[id];
         }
-        case DistributionType::even: {
-            std::string hashString = constructHash();
-
-            if (destinations_.find(hashString) != end(destinations_)) {
-                return destinations_.at(hashString);
-            }
-
-            auto it = std::min_element(begin(counters_), end(counters_));
-            auto id = static_cast<size_t>(std::distance(std::begin(counters_), it));
+        case DistributionType::consistent_hash: {
+            auto id = util::jumpConsistentHash(fieldHash(msg.metadata(), hashKeys_), serverCount_);
 
             ASSERT(id < serverPeers_.size());
-            ASSERT(id < counters_.size());
 
-            ++counters_[id];
+            return *serverPeers_[id];
+        }
+        case DistributionType::even:
+        case DistributionType::even_bytes: {
+            auto id = balanced_.server(fieldHash(msg.metadata(), hashKeys_), msg);
 
-            auto dest = *serverPeers_[id];
-            destinations_[hashString] = *serverPeers_[id];
+            ASSERT(id < serverPeers_.size());
 
-            return dest;
+            return *serverPeers_[id];
         }
         default:
             throw eckit::SeriousBug("Unhandled distribution type");
     }
 }
 
-Transport::DistributionType Transport::distributionType() {
+Transport::DistributionType Transport::distributionType(const eckit::Configuration& conf) {
     // std::map with transparent comparator std::less<> for string_view
     const std::map<std::string, enum DistributionType, std::less<>> str2dist
         = {{"hashed_cyclic", DistributionType::hashed_cyclic},
            {"hashed_to_single", DistributionType::hashed_to_single},
-           {"even", DistributionType::even}};
+           {"consistent_hash", DistributionType::consistent_hash},
+           {"even", DistributionType::even},
+           {"even_bytes", DistributionType::even_bytes}};
 
+    // The plan configuration takes precedence over the environment
     const char* envVar = "MULTIO_SERVER_DISTRIBUTION";
-    auto key = util::getEnv(envVar);
+    std::optional<std::string> key;
+    if (conf.has("distribution")) {
+        key = conf.getString("distribution");
+    }
+    else if (auto env = util::getEnv(envVar)) {
+        key = std::string{*env};
+    }
     if (!key)
         return DistributionType::hashed_to_single;
 
@@ -162,7 +145,7 @@ Transport::DistributionType Transport::distributionType() {
     if (it == str2dist.end()) {
         std::ostringstream oss;
         oss << "Transport::distributionType(): Unsupported distribution type \"" << (*key)
-            << "\" read from environment variable " << envVar << std::endl;
+            << "\" read from configuration or environment variable " << envVar << std::endl;
         throw transport::TransportException(oss.str(), Here());
     }
     return it->second;
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "multio/action/Action.h"
+#include "multio/action/transport/FieldDistribution.h"
 #include "multio/transport/Transport.h"  // This means circular dependency at the minute
 
 namespace eckit {
@@ -44,22 +45,25 @@ private:
     size_t serverId_;
     size_t usedServerCount_;
 
-    std::vector<std::string> hashKeys_;
+    std::vector<message::MetadataTypes::KeyType> hashKeys_;
 
     // Distribute fields
-    message::Peer chooseServer(const message::Metadata& metadata);
-    std::map<std::string, message::Peer> destinations_;
-    std::vector<uint64_t> counters_;
+    message::Peer chooseServer(const message::Message& msg);
 
     enum class DistributionType : unsigned
     {
         hashed_cyclic,
         hashed_to_single,
+        consistent_hash,
         even,
+        even_bytes,
     };
     DistributionType distType_;
 
-    enum DistributionType distributionType();
+    // Used by the even and even_bytes distributions
+    BalancedDistribution balanced_;
+
+    enum DistributionType distributionType(const eckit::Configuration& conf);
 };
 
 }  // namespace multio::action
@@ -18,6 +18,15 @@ inline int multio_write_field(multio_handle_t* mio, multio_metadata_t* md, const
     return (multio_write_field_double(mio, md, data, size));
 };
 
+inline int multio_write_fields(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                               const float* const* data, int size, int nfields) {
+    return (multio_write_fields_float(mio, md, key, values, data, size, nfields));
+};
+inline int multio_write_fields(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                               const double* const* data, int size, int nfields) {
+    return (multio_write_fields_double(mio, md, key, values, data, size, nfields));
+};
+
 
 // overloaded mask write
 inline int multio_write_mask(multio_handle_t* mio, multio_metadata_t* md, const float* data, int size) {
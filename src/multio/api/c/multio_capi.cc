@@ -19,6 +19,8 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 using multio::message::Message;
 using multio::message::Metadata;
@@ -241,6 +243,37 @@ int wrapApiFunction(FN&& f, multio_data_t* d) {
     return wrapApiFunction(std::forward<FN>(f), (d && d->mio) ? d->mio->failureContext.get() : nullptr);
 }
 
+// The metadata template is prepared once per batch, each field gets a copy with its own value for the varying key
+template <typename Precision>
+void writeFields(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                 const Precision* const* data, int size, int nfields) {
+    ASSERT(mio);
+    ASSERT(md);
+    ASSERT(key);
+    ASSERT(nfields >= 0);
+    ASSERT(nfields == 0 || (values && data));
+
+    md->md.acquire();  // Make sure metadata is not stored in a stateful container from last write
+    md->md.modify().set("precision", std::is_same_v<Precision, double> ? "double" : "single");
+    md->md.modify().set("format", "raw");
+
+    const Metadata& templateMd = md->md.read();
+    const Metadata::KeyType varyingKey{std::string(key)};
+
+    std::vector<Message> batch;
+    batch.reserve(nfields);
+    for (int i = 0; i < nfields; ++i) {
+        Metadata fieldMd{templateMd};
+        fieldMd.set(varyingKey, static_cast<std::int64_t>(values[i]));
+
+        multio::message::PayloadReference field_vals{const_cast<void*>(static_cast<const void*>(data[i])),
+                                                     size * sizeof(Precision)};
+        batch.emplace_back(Message::Header{Message::Tag::Field, Peer{}, Peer{}, std::move(fieldMd)}, field_vals);
+    }
+
+    mio->dispatch(std::move(batch));
+}
+
 }  // namespace
 
 extern "C" {
@@ -689,6 +722,33 @@ int multio_write_field_double(multio_handle_t* mio, multio_metadata_t* md, const
 }
 
 
+int multio_write_fields_float(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                              const float* const* data, int size, int nfields) {
+#if !defined(MULTIO_DUMMY_API)
+    return wrapApiFunction(
+        [mio, md, key, values, data, size, nfields]() {
+            writeFields<float>(mio, md, key, values, data, size, nfields);
+        },
+        mio);
+#else
+    return MULTIO_SUCCESS;
+#endif
+}
+
+int multio_write_fields_double(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                               const double* const* data, int size, int nfields) {
+#if !defined(MULTIO_DUMMY_API)
+    return wrapApiFunction(
+        [mio, md, key, values, data, size, nfields]() {
+            writeFields<double>(mio, md, key, values, data, size, nfields);
+        },
+        mio);
+#else
+    return MULTIO_SUCCESS;
+#endif
+}
+
+
 int multio_write_field_buffer(multio_handle_t* mio, multio_metadata_t* md, multio_data_t* d, int byte_size) {
 #if !defined(MULTIO_DUMMY_API)
     return wrapApiFunction(
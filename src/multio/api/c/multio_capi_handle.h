@@ -104,6 +104,35 @@ int multio_write_field_float(multio_handle_t* mio, multio_metadata_t* md, const
 int multio_write_field_double(multio_handle_t* mio, multio_metadata_t* md, const double* data, int size);
 
 
+/** Writes a batch of (partial) fields that share their metadata except for one integer key, e.g. all levels of a
+ * parameter. Metadata handling and plan traversal are done once per batch.
+ * \param mio Handle to the multio (client) instance
+ * \param md Metadata template shared by all fields of the batch
+ * \param key C-string key that varies per field (e.g. "level")
+ * \param values Array of nfields values for the varying key
+ * \param data Array of nfields pointers to the (float) field values
+ * \param size Size of each field
+ * \param nfields Number of fields in the batch
+ * \returns Return code (#MultioErrorValues)
+ */
+int multio_write_fields_float(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                              const float* const* data, int size, int nfields);
+
+
+/** Writes a batch of (partial) fields that share their metadata except for one integer key, e.g. all levels of a
+ * parameter. Metadata handling and plan traversal are done once per batch.
+ * \param mio Handle to the multio (client) instance
+ * \param md Metadata template shared by all fields of the batch
+ * \param key C-string key that varies per field (e.g. "level")
+ * \param values Array of nfields values for the varying key
+ * \param data Array of nfields pointers to the (double) field values
+ * \param size Size of each field
+ * \param nfields Number of fields in the batch
+ * \returns Return code (#MultioErrorValues)
+ */
+int multio_write_fields_double(multio_handle_t* mio, multio_metadata_t* md, const char* key, const long long* values,
+                               const double* const* data, int size, int nfields);
+
 /** Legacy: Writes (partial) fields already grib encoded
  * \param mio Handle to the multio (client) instance
  * \param gribdata Pointer to grib message
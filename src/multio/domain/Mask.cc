@@ -20,6 +20,29 @@
 namespace multio {
 namespace domain {
 
+namespace {
+std::shared_ptr<const MaskRuns> decodeRuns(const EncodedRunLengthPayload& encoded) {
+    auto runs = std::make_shared<MaskRuns>();
+    runs->size = encoded.size();
+
+    std::size_t offset = 0;
+    for (const auto& valLengthPair : encoded) {
+        std::size_t nextOffset = offset + valLengthPair.second;
+        if (valLengthPair.first && (nextOffset > offset)) {
+            if (!runs->valid.empty() && (runs->valid.back().second == offset)) {
+                runs->valid.back().second = nextOffset;
+            }
+            else {
+                runs->valid.emplace_back(offset, nextOffset);
+            }
+        }
+        offset = nextOffset;
+    }
+
+    return runs;
+}
+}  // namespace
+
 Mask& Mask::instance() {
     static Mask singleton;
     return singleton;
@@ -48,6 +71,17 @@ EncodedRunLengthPayload Mask::get(const std::string& bkey) const {
     return EncodedRunLengthPayload{bitmasks_.at(bkey)};
 }
 
+std::shared_ptr<const MaskRuns> Mask::getRuns(const std::string& bkey) const {
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    auto it = runs_.find(bkey);
+    if (it == std::end(runs_)) {
+        throw eckit::AssertionFailed("There is no bitmask for " + bkey);
+    }
+
+    return it->second;
+}
+
 void Mask::addPartialMask(message::Message msg) {
     // Using a lookup table for sanity check
 
@@ -77,7 +111,8 @@ void Mask::createBitmask(message::Message inMsg) {
     // Assert invariants such are bound to be creating this the first and last time
     auto bkey = Mask::key(inMsg.metadata());
     // bitmasks_[bkey] = std::move(bitmask);
-    bitmasks_.insert_or_assign(bkey, encodeMaskRunLength(bitmask, bitmask.size()));
+    auto it = bitmasks_.insert_or_assign(bkey, encodeMaskRunLength(bitmask, bitmask.size())).first;
+    runs_.insert_or_assign(bkey, decodeRuns(EncodedRunLengthPayload{it->second}));
 
     messages_.at(inMsg.fieldId()).clear();
 }
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -18,6 +19,13 @@ class LocalConfiguration;
 
 namespace multio::domain {
 
+// Decoded form of a run-length encoded mask, computed once per mask key.
+// Unmasked (valid) points are given as half-open index ranges [first, second) in ascending order.
+struct MaskRuns {
+    std::size_t size = 0;
+    std::vector<std::pair<std::size_t, std::size_t>> valid;
+};
+
 class Mask {
 public:
     Mask() = default;
@@ -37,6 +45,8 @@ public:
     // const std::vector<bool>& get(const std::string& name) const;
     EncodedRunLengthPayload get(const std::string& name) const;
 
+    std::shared_ptr<const MaskRuns> getRuns(const std::string& name) const;
+
 private:
     void addPartialMask(message::Message msg);
 
@@ -46,6 +56,7 @@ private:
     std::unordered_map<std::string, std::vector<message::Message>> messages_;
     // std::unordered_map<std::string, std::vector<bool>> bitmasks_;
     std::unordered_map<std::string, eckit::Buffer> bitmasks_;
+    std::unordered_map<std::string, std::shared_ptr<const MaskRuns>> runs_;
 
     mutable std::mutex mutex_;
 };
@@ -15,10 +15,17 @@
 #include "multio/fdb5/FDB5Sink.h"
 #include "multio/LibMultio.h"
 
+#include <cctype>
+#include <sstream>
+#include <variant>
+
 #include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
 #include "eckit/value/Value.h"
 #include "fdb5/config/Config.h"
 #include "multio/util/Substitution.h"
+#include "multio/util/VariantHelpers.h"
 
 
 namespace multio::sink {
@@ -66,22 +73,129 @@ fdb5::Config fdb5_configuration(const ComponentConfiguration& compConf) {
 
 FDB5Sink::FDB5Sink(const ComponentConfiguration& compConf) : DataSink(compConf), fdb_{fdb5_configuration(compConf)} {
     LOG_DEBUG_LIB(LibMultio) << "Config = " << compConf.parsedConfig() << std::endl;
+
+    const auto& cfg = compConf.parsedConfig();
+    for (const auto& name : cfg.getStringVector("archive-keys", {})) {
+        if (name.empty()) {
+            throw eckit::UserError("FDB5Sink: empty name in archive-keys", Here());
+        }
+        auto marsName = name;
+        marsName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(marsName[0])));
+        archiveKeys_.push_back(ArchiveKey{name, name, "mars" + marsName});
+    }
+
+    if (cfg.getBool("async", false)) {
+        archiver_ = std::make_unique<SinkWriter>(
+            [this](SinkWriter::Item msg) { std::visit([this](const auto& m) { archive(m); }, msg); },
+            [this]() { fdb_.flush(); }, cfg.getUnsigned("queue-size", 1024), "FDB5Sink");
+    }
+}
+
+FDB5Sink::~FDB5Sink() {
+    if (archiver_) {
+        try {
+            archiver_->wait();
+        }
+        catch (const std::exception& e) {
+            eckit::Log::error() << "FDB5Sink: archiving failed: " << e.what() << std::endl;
+        }
+
+        std::ostringstream oss;
+        archiver_->report(oss);
+        LOG_DEBUG_LIB(LibMultio) << oss.str();
+
+        archiver_.reset();
+    }
 }
 
 void FDB5Sink::write(eckit::message::Message msg) {
     LOG_DEBUG_LIB(LibMultio) << "FDB5Sink::write()" << std::endl;
 
+    if (archiver_) {
+        archiver_->write(std::move(msg));
+        return;
+    }
+
+    archive(msg);
+}
+
+void FDB5Sink::write(const message::Message& msg) {
+    LOG_DEBUG_LIB(LibMultio) << "FDB5Sink::write()" << std::endl;
+
+    if (archiveKeys_.empty()) {
+        DataSink::write(msg);
+        return;
+    }
+
+    if (archiver_) {
+        // The payload may reference the caller's buffer, which can be reused as soon as this returns
+        message::Message queued{msg};
+        if (queued.payload().isReference()) {
+            queued.acquirePayload();
+        }
+        archiver_->write(std::move(queued));
+        return;
+    }
+
+    archive(msg);
+}
+
+void FDB5Sink::archive(const eckit::message::Message& msg) {
     fdb_.archive(msg);
 }
 
+void FDB5Sink::archive(const message::Message& msg) {
+    fdb_.archive(archiveKey(msg.metadata()), msg.payload().data(), msg.size());
+}
+
+fdb5::Key FDB5Sink::archiveKey(const message::Metadata& md) const {
+    fdb5::Key key;
+    for (const auto& k : archiveKeys_) {
+        auto it = md.find(k.key);
+        if (it == md.end()) {
+            it = md.find(k.marsKey);
+        }
+        if (it == md.end()) {
+            std::ostringstream oss;
+            oss << "FDB5Sink: Archive key \"" << k.name << "\" is missing from the metadata, neither \"" << k.key
+                << "\" nor \"" << k.marsKey << "\" is set";
+            throw eckit::UserError(oss.str(), Here());
+        }
+
+        auto value = util::visitTranslate<std::string>(it->second);
+        if (!value) {
+            std::ostringstream oss;
+            oss << "FDB5Sink: Value of archive key \"" << k.name << "\" can not be translated to string: "
+                << it->second;
+            throw eckit::UserError(oss.str(), Here());
+        }
+        key.set(k.name, *value);
+    }
+    return key;
+}
+
 void FDB5Sink::flush() {
     LOG_DEBUG_LIB(LibMultio) << "FDB5Sink::flush()" << std::endl;
 
+    if (archiver_) {
+        if (lastFlush_) {
+            archiver_->waitFlushed(*lastFlush_);
+        }
+        lastFlush_ = archiver_->flush();
+        return;
+    }
+
     fdb_.flush();
 }
 
+void FDB5Sink::sync() {
+    if (archiver_ && lastFlush_) {
+        archiver_->waitFlushed(*lastFlush_);
+    }
+}
+
 void FDB5Sink::print(std::ostream& os) const {
-    os << "FDB5Sink()";
+    os << "FDB5Sink(" << (archiver_ ? "async" : "") << ")";
 }
 
 static DataSinkBuilder<FDB5Sink> FDB5SinkBuilder("fdb5");
@@ -15,26 +15,48 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "fdb5/api/FDB.h"
+#include "fdb5/database/Key.h"
 
 #include "multio/sink/DataSink.h"
+#include "multio/sink/SinkWriter.h"
 
 namespace multio::sink {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+/// Archives messages to FDB5.
+///
+/// With "async" set, archiving and flushing happen on a background thread fed by a queue of "queue-size" messages.
+/// flush() then only queues the flush, and waits for the previous one to complete first, so that the caller is held up
+/// only if a flush takes longer than the data in between. sync() waits for the last flush, after which its data is
+/// visible in FDB. Errors are rethrown by the next write, flush or sync.
+///
+/// With "archive-keys" set, multio messages are archived under a key built from their metadata instead of having
+/// eccodes parse the encoded data. Each listed FDB key is looked up in the metadata by its name, or else by its MARS
+/// name (e.g. class as marsClass). A message missing a key under both names is not archived, it raises a UserError.
 class FDB5Sink : public DataSink {
 public:
     explicit FDB5Sink(const config::ComponentConfiguration& compConf);
 
+    ~FDB5Sink() override;
+
 private:
+    using DataSink::write;
+
     void write(eckit::message::Message msg) override;
 
+    void write(const message::Message& msg) override;
+
     void flush() override;
 
+    void sync() override;
+
     void print(std::ostream&) const override;
 
     friend std::ostream& operator<<(std::ostream& s, const FDB5Sink& p) {
@@ -42,7 +64,23 @@ private:
         return s;
     }
 
+    void archive(const eckit::message::Message& msg);
+    void archive(const message::Message& msg);
+
+    fdb5::Key archiveKey(const message::Metadata& md) const;
+
+    struct ArchiveKey {
+        std::string name;
+        message::Metadata::KeyType key;
+        message::Metadata::KeyType marsKey;
+    };
+    std::vector<ArchiveKey> archiveKeys_;
+
     fdb5::FDB fdb_;
+
+    // Set if asynchronous, uses fdb_ and is stopped before it
+    std::unique_ptr<SinkWriter> archiver_;
+    std::optional<SinkWriter::Ticket> lastFlush_;
 };
 
 }  // namespace multio::sink
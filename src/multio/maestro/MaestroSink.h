@@ -36,6 +36,8 @@ public:
     ~MaestroSink() override;
 
 private:
+    using DataSink::write;
+
     void write(eckit::message::Message blob) override;
 
     void flush() override;
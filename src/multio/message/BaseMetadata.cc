@@ -21,10 +21,13 @@ namespace multio::message {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+BaseMetadata::BaseMetadata() : values_{} {}
+BaseMetadata::BaseMetadata(std::initializer_list<std::pair<const KeyType, MetadataValue>> li) : values_{li} {}
+
 // Constructor for unordered_map
-BaseMetadata::BaseMetadata() : values_{512} {}
-BaseMetadata::BaseMetadata(std::initializer_list<std::pair<const KeyType, MetadataValue>> li) :
-    values_{std::move(li), 512} {}
+// BaseMetadata::BaseMetadata() : values_{512} {}
+// BaseMetadata::BaseMetadata(std::initializer_list<std::pair<const KeyType, MetadataValue>> li) :
+//     values_{std::move(li), 512} {}
 
 // Construtore for map
 // BaseMetadata::BaseMetadata() : values_{} {}
@@ -103,6 +103,7 @@ public:
         return values_.try_emplace(k, std::forward<V>(v));
     }
 
+    // Like for a vector, adding or erasing values invalidates iterators
     using Iterator = typename MapType::iterator;
     using ConstIterator = typename MapType::const_iterator;
 
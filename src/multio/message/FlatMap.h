@@ -0,0 +1,212 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace multio::message {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Map of interned keys (see InternedKey) stored contiguously in insertion order. The positions of the keys with the
+ * lowest ids, which include all glossary keys, are kept in a direct index, so looking them up is a single array access.
+ * Other keys are found by a linear scan comparing key pointers, which for the few dozen entries of typical metadata
+ * is faster than hashing.
+ *
+ * Provides the subset of the std::unordered_map interface used by BaseMetadata. Unlike std::unordered_map, inserting
+ * or erasing invalidates existing iterators.
+ */
+template <typename Key, typename Value>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    // Keys with an id below this are indexed directly, positions from npos on are found by scanning
+    static constexpr std::size_t indexedKeys = 256;
+
+    FlatMap() { index_.fill(npos); }
+
+    FlatMap(std::initializer_list<std::pair<const Key, Value>> li) : FlatMap() {
+        values_.reserve(li.size());
+        for (const auto& kv : li) {
+            insert_or_assign(kv.first, kv.second);
+        }
+    }
+
+    FlatMap(const FlatMap&) = default;
+    FlatMap& operator=(const FlatMap&) = default;
+
+    FlatMap(FlatMap&& other) noexcept : values_{std::move(other.values_)}, index_{other.index_} { other.clear(); }
+
+    FlatMap& operator=(FlatMap&& other) noexcept {
+        values_ = std::move(other.values_);
+        index_ = other.index_;
+        other.clear();
+        return *this;
+    }
+
+    iterator begin() noexcept { return values_.begin(); }
+    const_iterator begin() const noexcept { return values_.begin(); }
+    const_iterator cbegin() const noexcept { return values_.cbegin(); }
+    iterator end() noexcept { return values_.end(); }
+    const_iterator end() const noexcept { return values_.end(); }
+    const_iterator cend() const noexcept { return values_.cend(); }
+
+    bool empty() const noexcept { return values_.empty(); }
+    size_type size() const noexcept { return values_.size(); }
+
+    void reserve(size_type n) { values_.reserve(n); }
+
+    void clear() noexcept {
+        values_.clear();
+        index_.fill(npos);
+    }
+
+    iterator find(const Key& k) { return begin() + position(k); }
+    const_iterator find(const Key& k) const { return begin() + position(k); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& k, Args&&... args) {
+        if (auto pos = position(k); pos != size()) {
+            return {begin() + pos, false};
+        }
+        return {append(k, std::forward<Args>(args)...), true};
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key& k, V&& v) {
+        if (auto pos = position(k); pos != size()) {
+            values_[pos].second = std::forward<V>(v);
+            return {begin() + pos, false};
+        }
+        return {append(k, std::forward<V>(v)), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+    std::pair<iterator, bool> insert(value_type&& kv) { return try_emplace(kv.first, std::move(kv.second)); }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            try_emplace(first->first, first->second);
+        }
+    }
+
+    Value& operator[](const Key& k) { return try_emplace(k).first->second; }
+
+    size_type erase(const Key& k) {
+        if (auto pos = position(k); pos != size()) {
+            erase(cbegin() + pos);
+            return 1;
+        }
+        return 0;
+    }
+
+    iterator erase(iterator it) { return erase(const_iterator{it}); }
+
+    iterator erase(const_iterator it) { return erase(it, std::next(it)); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto pos = static_cast<size_type>(first - cbegin());
+        for (auto it = first; it != last; ++it) {
+            unindex(it->first);
+        }
+        auto res = values_.erase(first, last);
+        reindexFrom(pos);
+        return res;
+    }
+
+    /// Moves the entries of other whose keys are not contained in this map, like std::unordered_map::merge
+    void merge(FlatMap& other) {
+        std::vector<value_type> kept;
+        for (auto& kv : other.values_) {
+            if (position(kv.first) == size()) {
+                append(kv.first, std::move(kv.second));
+            }
+            else {
+                kept.push_back(std::move(kv));
+            }
+        }
+        other.values_ = std::move(kept);
+        other.index_.fill(npos);
+        other.reindexFrom(0);
+    }
+
+    void merge(FlatMap&& other) { merge(other); }
+
+private:
+    using Position = std::uint8_t;
+    static constexpr Position npos = 0xff;
+
+    size_type position(const Key& k) const {
+        if (k.id() < indexedKeys) {
+            const auto p = index_[k.id()];
+            if (p != npos) {
+                return p;
+            }
+            if (size() <= npos) {
+                return size();
+            }
+        }
+        for (size_type i = 0; i < size(); ++i) {
+            if (values_[i].first == k) {
+                return i;
+            }
+        }
+        return size();
+    }
+
+    template <typename... Args>
+    iterator append(const Key& k, Args&&... args) {
+        values_.emplace_back(std::piecewise_construct, std::forward_as_tuple(k),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+        index(k, size() - 1);
+        return std::prev(end());
+    }
+
+    void index(const Key& k, size_type pos) {
+        if ((k.id() < indexedKeys) && (pos < npos)) {
+            index_[k.id()] = static_cast<Position>(pos);
+        }
+    }
+
+    void unindex(const Key& k) {
+        if (k.id() < indexedKeys) {
+            index_[k.id()] = npos;
+        }
+    }
+
+    void reindexFrom(size_type pos) {
+        for (; pos < size(); ++pos) {
+            index(values_[pos].first, pos);
+        }
+    }
+
+    std::vector<value_type> values_;
+    std::array<Position, indexedKeys> index_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::message
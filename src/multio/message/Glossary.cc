@@ -16,4 +16,9 @@ const Glossary& glossary() {
     return Glossary::instance();
 }
 
+namespace {
+// Intern the glossary keys at load time, so that they get the low ids that metadata lookups index directly
+[[maybe_unused]] const Glossary& internGlossary = glossary();
+}  // namespace
+
 }  // namespace multio::message
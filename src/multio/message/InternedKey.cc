@@ -0,0 +1,77 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/message/InternedKey.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+namespace multio::message {
+
+namespace {
+
+class KeyTable {
+public:
+    static KeyTable& instance() {
+        static KeyTable table;
+        return table;
+    }
+
+    const InternedKey::Entry* intern(std::string_view v) {
+        // Keys seen by this thread are found without touching the shared table
+        thread_local std::unordered_map<std::string_view, const InternedKey::Entry*> cache;
+        if (auto it = cache.find(v); it != cache.end()) {
+            return it->second;
+        }
+
+        const auto* entry = internShared(v);
+        cache.emplace(std::string_view{entry->value}, entry);
+        return entry;
+    }
+
+private:
+    const InternedKey::Entry* internShared(std::string_view v) {
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex_};
+            if (auto it = index_.find(v); it != index_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock{mutex_};
+        if (auto it = index_.find(v); it != index_.end()) {
+            return it->second;
+        }
+
+        // Entries never move nor go away, the indices refer to their strings
+        const auto hash = std::hash<std::string_view>{}(v);
+        const auto id = static_cast<std::uint32_t>(entries_.size());
+        const auto& entry = entries_.emplace_back(InternedKey::Entry{std::string{v}, hash, id});
+        index_.emplace(std::string_view{entry.value}, &entry);
+        return &entry;
+    }
+
+    std::shared_mutex mutex_;
+    std::deque<InternedKey::Entry> entries_;
+    std::unordered_map<std::string_view, const InternedKey::Entry*> index_;
+};
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+InternedKey::InternedKey(std::string_view v) : entry_{KeyTable::instance().intern(v)} {}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::message
@@ -0,0 +1,99 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "eckit/log/JSON.h"
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+namespace multio::message {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Metadata key interned in a process-wide table. Each distinct string is stored once and gets a dense id in the order
+ * the keys are first seen; the glossary keys are interned first. Copying and comparing keys for equality is a pointer
+ * operation, constructing one from a string is a lookup in the table that only allocates for a string not seen before.
+ */
+class InternedKey {
+public:
+    using ValueType = std::string;
+    using HashType = std::size_t;
+
+    struct Entry {
+        std::string value;
+        HashType hash;
+        std::uint32_t id;
+    };
+
+    InternedKey(std::string_view v);
+    InternedKey(const std::string& v) : InternedKey{std::string_view{v}} {}
+    InternedKey(const char* v) : InternedKey{std::string_view{v}} {}
+
+    template <typename TC, std::enable_if_t<(!std::is_convertible_v<TC, std::string_view>
+                                             && std::is_constructible_v<std::string, TC>),
+                                            bool> = true>
+    InternedKey(TC&& v) : InternedKey{std::string_view{std::string(std::forward<TC>(v))}} {}
+
+    operator const std::string&() const noexcept { return entry_->value; }
+
+    const std::string& value() const noexcept { return entry_->value; }
+
+    const HashType& hash() const noexcept { return entry_->hash; }
+
+    /// Dense id in the order of interning
+    std::uint32_t id() const noexcept { return entry_->id; }
+
+    bool operator==(const InternedKey& rhs) const noexcept { return entry_ == rhs.entry_; }
+    bool operator!=(const InternedKey& rhs) const noexcept { return entry_ != rhs.entry_; }
+
+    // Lexicographic, so that ordered containers of keys print as before
+    bool operator<(const InternedKey& rhs) const noexcept {
+        return (entry_ != rhs.entry_) && (entry_->value < rhs.entry_->value);
+    }
+
+private:
+    const Entry* entry_;
+};
+
+
+inline std::ostream& operator<<(std::ostream& os, const InternedKey& k) {
+    os << k.value();
+    return os;
+};
+
+inline eckit::JSON& operator<<(eckit::JSON& json, const InternedKey& k) {
+    json << k.value();
+    return json;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+
+}  // namespace multio::message
+
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template <>
+struct std::hash<multio::message::InternedKey> {
+    using HashType = typename multio::message::InternedKey::HashType;
+
+    HashType operator()(const multio::message::InternedKey& t) const noexcept { return t.hash(); };
+};
+
+//----------------------------------------------------------------------------------------------------------------------
@@ -27,7 +27,7 @@ namespace multio {
 namespace message {
 
 int Message::protocolVersion() {
-    return 1;
+    return 2;
 }
 
 std::string Message::tag2str(Tag t) {
@@ -118,6 +118,10 @@ const std::string& Message::fieldId() const {
     return header().fieldId();
 }
 
+const Message::Origin& Message::origin() const {
+    return header().origin();
+}
+
 const Metadata& Message::metadata() const {
     return header_.metadata();
 }
@@ -191,9 +195,32 @@ void LogMessage::print(std::ostream& out) const {
         << ")";
 }
 
+namespace {
+
+// Holds the message before the data content base is constructed from it
+struct OwnedMessage {
+    explicit OwnedMessage(const Message& msg) : msg_{msg} {
+        // A payload referring to the caller's array may be gone by the time an asynchronous sink writes it
+        if (msg_.payload().isReference()) {
+            msg_.acquirePayload();
+        }
+    }
+
+    Message msg_;
+};
+
+// Refers to the payload of a message and keeps it alive, as sinks may write it asynchronously
+class MessageDataContent : private OwnedMessage, public metkit::codes::UserDataContent {
+public:
+    explicit MessageDataContent(const Message& msg) :
+        OwnedMessage{msg}, metkit::codes::UserDataContent(msg_.payload().data(), msg_.size()) {}
+};
+
+}  // namespace
+
 eckit::message::Message to_eckit_message(const Message& msg) {
     ASSERT(msg.tag() == Message::Tag::Field);
-    return eckit::message::Message{new metkit::codes::UserDataContent(msg.payload().data(), msg.size())};
+    return eckit::message::Message{new MessageDataContent(msg)};
 }
 
 }  // namespace message
@@ -25,6 +25,7 @@
 #include "multio/message/SharedMetadata.h"
 #include "multio/message/SharedPayload.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -71,6 +72,19 @@ public:  // types
         mutable std::optional<std::string> fieldId_;
     };
 
+    /// Stamp of the client write of a field, carried along for end-to-end latency. The time is in nanoseconds of the
+    /// system clock, since the client and server ranks may run on different nodes. 0 if the message is not stamped.
+    struct Origin {
+        std::int64_t time = 0;
+        std::uint64_t sequence = 0;
+
+        /// Current time with the next sequence number of this process
+        static Origin now();
+
+        void encode(eckit::Stream& strm) const;
+        static Origin decode(eckit::Stream& strm);
+    };
+
     class Header {
     public:
         Header(const Header&) = default;
@@ -102,7 +116,11 @@ public:  // types
 
         const std::string& fieldId() const;
 
+        const Origin& origin() const;
+        void setOrigin(const Origin& origin);
+
         void encode(eckit::Stream& strm) const;
+        static Header decode(eckit::Stream& strm);
 
         const Metadata& metadata() const;
 
@@ -126,6 +144,8 @@ public:  // types
         SharedMetadata metadata_;
         // encode fieldId_ lazily
         mutable std::optional<std::string> fieldId_;  // Make that a hash?
+
+        Origin origin_;
     };
 
 
@@ -170,6 +190,8 @@ public:
 
     const std::string& fieldId() const;
 
+    const Origin& origin() const;
+
     // Metadata&& metadata() &&;
 
     const Metadata& metadata() const;
@@ -230,7 +252,7 @@ message::Message convert_precision(message::Message&& msg) {
     eckit::Buffer buffer(N * sizeof(To));
 
     auto md = msg.metadata();
-    md.set<std::int64_t>("globalSize", buffer.size());
+    md.set<std::int64_t>("globalSize", N);
     md.set("precision", std::is_same_v<To, double> ? "double" : std::is_same_v<To, float> ? "single" : NOTIMP);
 
     const auto* a = reinterpret_cast<const From*>(msg.payload().data());
@@ -239,7 +261,9 @@ message::Message convert_precision(message::Message&& msg) {
         *(b++) = static_cast<To>(*(a++));
     }
 
-    return {message::Message::Header{msg.tag(), msg.source(), msg.destination(), std::move(md)}, std::move(buffer)};
+    message::Message::Header header{msg.tag(), msg.source(), msg.destination(), std::move(md)};
+    header.setOrigin(msg.origin());
+    return {std::move(header), std::move(buffer)};
 }
 
 
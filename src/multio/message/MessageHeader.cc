@@ -10,12 +10,71 @@
 
 #include "Message.h"
 
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <streambuf>
+
 #include "Glossary.h"
 #include "eckit/config/YAMLConfiguration.h"
+#include "eckit/log/JSON.h"
 #include "eckit/serialisation/Stream.h"
 
 namespace multio::message {
 
+namespace {
+
+// Appends to a string that keeps its capacity between messages
+class StringAppendBuffer : public std::streambuf {
+public:
+    explicit StringAppendBuffer(std::string& str) : str_{str} {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            str_.push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        str_.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    std::string& str_;
+};
+
+struct EncodeBuffer {
+    std::string str;
+    StringAppendBuffer buffer{str};
+    std::ostream os{&buffer};
+};
+
+}  // namespace
+
+Message::Origin Message::Origin::now() {
+    static std::atomic<std::uint64_t> sequence{0};
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    return Origin{static_cast<std::int64_t>(time), sequence.fetch_add(1, std::memory_order_relaxed) + 1};
+}
+
+void Message::Origin::encode(eckit::Stream& strm) const {
+    strm << static_cast<long long>(time);
+    strm << static_cast<unsigned long long>(sequence);
+}
+
+Message::Origin Message::Origin::decode(eckit::Stream& strm) {
+    long long time;
+    strm >> time;
+    unsigned long long sequence;
+    strm >> sequence;
+    return Origin{static_cast<std::int64_t>(time), static_cast<std::uint64_t>(sequence)};
+}
+
 Message::Header::Header(Tag tag, Peer src, Peer dst, std::string&& fieldId) :
     tag_{tag},
     source_{std::move(src)},
@@ -117,6 +176,14 @@ const std::string& Message::Header::fieldId() const {
     return *fieldId_;
 }
 
+const Message::Origin& Message::Header::origin() const {
+    return origin_;
+}
+
+void Message::Header::setOrigin(const Origin& origin) {
+    origin_ = origin;
+}
+
 void Message::Header::encode(eckit::Stream& strm) const {
     strm << static_cast<unsigned>(tag_);
 
@@ -126,7 +193,41 @@ void Message::Header::encode(eckit::Stream& strm) const {
     strm << destination_.group();
     strm << destination_.id();
 
-    strm << fieldId();
+    if (fieldId_) {
+        strm << *fieldId_;
+    }
+    else {
+        // Serialise the shared metadata through a per-thread buffer rather than caching a copy of it in every header
+        thread_local EncodeBuffer encoded;
+        encoded.str.clear();
+        eckit::JSON json{encoded.os};
+        json << metadata_.read();
+        strm << encoded.str;
+    }
+
+    origin_.encode(strm);
+}
+
+Message::Header Message::Header::decode(eckit::Stream& strm) {
+    unsigned t;
+    strm >> t;
+
+    std::string srcGroup;
+    strm >> srcGroup;
+    size_t srcId;
+    strm >> srcId;
+
+    std::string destGroup;
+    strm >> destGroup;
+    size_t destId;
+    strm >> destId;
+
+    std::string fieldId;
+    strm >> fieldId;
+
+    Header header{static_cast<Tag>(t), Peer{srcGroup, srcId}, Peer{destGroup, destId}, std::move(fieldId)};
+    header.setOrigin(Origin::decode(strm));
+    return header;
 }
 
 Message::LogHeader Message::Header::logHeader() const {
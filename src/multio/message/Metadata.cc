@@ -31,10 +31,10 @@ typename Metadata::Iterator Metadata::find(const KeyType& k) {
         return localIt;
     }
 
-    const auto& global = Parametrization::instance().get();
-    auto globalIt = global.find(k);
-    if (globalIt != values_.end()) {
-        return values_.insert(*globalIt).first;
+    // Parametrized values are shared by all threads and must not be written through the returned iterator - they are
+    // copied in. Like any insertion, this invalidates iterators and references to other values handed out before
+    if (auto globalIt = Parametrization::instance().find(k)) {
+        return values_.insert(**globalIt).first;
     }
 
     // Nothing is found - make sure an proper iterator is returned to allow users to have a proper comparison with
@@ -48,11 +48,8 @@ typename Metadata::ConstIterator Metadata::find(const KeyType& k) const {
         return localIt;
     }
 
-    const auto& global = Parametrization::instance().get();
-    auto globalIt = global.find(k);
-    if (globalIt != values_.end()) {
-        // TODO - returning an iterator of a different class might be critical here?
-        return globalIt;
+    if (auto globalIt = Parametrization::instance().find(k)) {
+        return *globalIt;
     }
 
     // Nothing is found - make sure an proper iterator is returned to allow users to have a proper comparison with
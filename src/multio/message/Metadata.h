@@ -52,14 +52,10 @@ public:
     using ConstIterator = typename MapType::const_iterator;
 
     // The single place we need to change to support lookups in parametrization.
-    // Important: The non-const version will copy values from the global parametrization dictionary
-    //            to the local one - It will always return an iterator to the local dictionary.
-    //            This allows values to be modified in the local object directly.
-    //
-    //            The const version will return either an iterator to the local object or the
-    //            global parametrization dictionary.
-    //            If keys are assumed to hold nested objects or large arrays which won't be modified anyway -
-    //            it is reasonable to explicitly const-cast the object to select the const lookup version.
+    // Important: The const version returns either an iterator to the local object or to the global parametrization
+    //            dictionary, it never inserts. The non-const version copies a parametrized value into the local
+    //            object, so that writing through the iterator does not modify the parametrization shared by all
+    //            metadata. Like any insertion, this invalidates iterators and references to other local values.
     Iterator find(const KeyType& k) override;
     ConstIterator find(const KeyType& k) const override;
 
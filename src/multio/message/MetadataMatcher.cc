@@ -114,6 +114,29 @@ bool MatchKeys::matches(const Metadata& md) const {
     }
 }
 
+std::optional<MatchKeys::ValueSet> MatchKeys::requiredValues(const KeyType& key) const {
+    // A negated matcher can be satisfied by any value
+    if (predicate_ == Predicate::Negate) {
+        return std::nullopt;
+    }
+    for (const auto& kv : matcher_) {
+        if (kv.first == key) {
+            return kv.second;
+        }
+    }
+    return std::nullopt;
+}
+
+void MatchKeys::constrainedKeys(std::set<KeyType>& keys) const {
+    if (predicate_ == Predicate::Negate) {
+        return;
+    }
+    for (const auto& kv : matcher_) {
+        keys.insert(kv.first);
+    }
+}
+
+
 namespace {
 
 Predicate negatePredicate(Predicate p) {
@@ -340,6 +363,60 @@ bool MatchReduce::matches(const Metadata& md) const {
     }
 }
 
+std::optional<MatchKeys::ValueSet> MatchReduce::requiredValues(const MatchKeys::KeyType& key) const {
+    if (predicate_ == Predicate::Negate) {
+        return std::nullopt;
+    }
+
+    auto requiredValuesOf = [&](const Elem& matcher) {
+        return std::visit(
+            eckit::Overloaded{[&](const MatchKeys& mk) { return mk.requiredValues(key); },
+                              [&](const std::shared_ptr<MatchReduce>& mr) { return mr->requiredValues(key); }},
+            matcher);
+    };
+
+    std::optional<MatchKeys::ValueSet> res;
+    if (reduce_ == Reduce::Or) {
+        // Any: union of all alternatives, unconstrained as soon as one alternative is
+        res.emplace();
+        for (const auto& matcher : matchers_) {
+            auto values = requiredValuesOf(matcher);
+            if (!values) {
+                return std::nullopt;
+            }
+            res->insert(values->begin(), values->end());
+        }
+    }
+    else {
+        // All: intersection of all constraining matchers
+        for (const auto& matcher : matchers_) {
+            auto values = requiredValuesOf(matcher);
+            if (!values) {
+                continue;
+            }
+            if (!res) {
+                res = std::move(values);
+                continue;
+            }
+            for (auto it = res->begin(); it != res->end();) {
+                it = (values->find(*it) == values->end()) ? res->erase(it) : std::next(it);
+            }
+        }
+    }
+    return res;
+}
+
+void MatchReduce::constrainedKeys(std::set<MatchKeys::KeyType>& keys) const {
+    if (predicate_ == Predicate::Negate) {
+        return;
+    }
+    for (const auto& matcher : matchers_) {
+        std::visit(eckit::Overloaded{[&](const MatchKeys& mk) { mk.constrainedKeys(keys); },
+                                     [&](const std::shared_ptr<MatchReduce>& mr) { mr->constrainedKeys(keys); }},
+                   matcher);
+    }
+}
+
 bool MatchReduce::isEmpty() const {
     return matchers_.empty();
 }
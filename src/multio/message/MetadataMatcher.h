@@ -14,6 +14,8 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -49,10 +51,20 @@ enum class Reduce : unsigned
 class MatchKeys {
 
 public:  // methods
+    using KeyType = typename MetadataTypes::KeyType;
+    using ValueSet = std::unordered_set<MetadataValue>;
+
     explicit MatchKeys(const eckit::LocalConfiguration& cfg, Predicate p, bool enforceMatchKeys);
 
     bool matches(const Metadata& md) const;
 
+    /// Values the key must have for a match, std::nullopt if the key is not constrained.
+    /// A necessary (not sufficient) condition, used to index plans by their selectors.
+    std::optional<ValueSet> requiredValues(const KeyType& key) const;
+
+    /// Collects all keys that may be constrained through `requiredValues`
+    void constrainedKeys(std::set<KeyType>& keys) const;
+
 private:  // methods
     friend std::ostream& operator<<(std::ostream& os, const MatchKeys& m) {
         m.print(os);
@@ -91,6 +103,11 @@ public:  // methods
 
     bool matches(const Metadata& md) const;
 
+    /// @see MatchKeys::requiredValues
+    std::optional<MatchKeys::ValueSet> requiredValues(const MatchKeys::KeyType& key) const;
+
+    void constrainedKeys(std::set<MatchKeys::KeyType>& keys) const;
+
     bool isEmpty() const;
 
     void extend(const MatchKeys&);
@@ -14,7 +14,8 @@
 
 #pragma once
 
-#include "multio/message/PrehashedKey.h"
+#include "multio/message/FlatMap.h"
+#include "multio/message/InternedKey.h"
 #include "multio/util/TypeTraits.h"
 
 #include "eckit/log/JSON.h"
@@ -69,10 +70,11 @@ eckit::JSON& operator<<(eckit::JSON& json, const Null&);
 // that a unique_ptr is used is hidden from the user.
 struct MetadataTypes {
     // using KeyType = std::string;
-    using KeyType = PrehashedKey<std::string>;
+    // using KeyType = PrehashedKey<std::string>;
+    using KeyType = InternedKey;
 
     template <typename ValueType>
-    using MapType = std::unordered_map<KeyType, ValueType>;
+    using MapType = FlatMap<KeyType, ValueType>;
 
 
     using Nulls = util::TypeList<Null>;
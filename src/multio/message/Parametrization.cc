@@ -25,31 +25,60 @@ Parametrization& Parametrization::instance() {
     return singleton;
 }
 
-BaseMetadata& Parametrization::get() {
-    return data_;
+Parametrization::Parametrization() = default;
+
+BaseMetadata Parametrization::get() const {
+    std::vector<const Layer*> layers;
+    for (const auto* layer = current_.load(std::memory_order_acquire); layer; layer = layer->previous.get()) {
+        layers.push_back(layer);
+    }
+
+    BaseMetadata all;
+    for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
+        all.updateNoOverwrite((*it)->values);
+    }
+    return all;
+}
+
+std::optional<BaseMetadata::ConstIterator> Parametrization::find(const BaseMetadata::KeyType& key) const {
+    for (const auto* layer = current_.load(std::memory_order_acquire); layer; layer = layer->previous.get()) {
+        if (auto it = layer->values.find(key); it != layer->values.end()) {
+            return it;
+        }
+    }
+    return std::nullopt;
 }
 
 void Parametrization::clear() {
-    data_ = BaseMetadata{};
+    std::lock_guard<std::mutex> lock{mutex_};
+    current_.store(nullptr, std::memory_order_release);
+    if (head_) {
+        cleared_.push_back(std::move(head_));
+    }
 }
 
 
 void Parametrization::update(const BaseMetadata& other) {
     std::lock_guard<std::mutex> lock{mutex_};
 
+    BaseMetadata added;
     for (const auto& kv : other) {
         if (kv.first.value() != PARAMETRIZATION_PAYLOAD_KEY) {
-            update(kv.first, kv.second);
+            update(added, kv.first, kv.second);
         }
     }
+    publish(std::move(added));
 };
 
 
 void Parametrization::update(const std::string& key, const void* data, std::size_t size) {
     std::lock_guard<std::mutex> lock{mutex_};
 
-    update(key, MetadataValue{std::vector<unsigned char>(static_cast<const unsigned char*>(data),
-                                                         static_cast<const unsigned char*>(data) + size)});
+    BaseMetadata added;
+    update(added, key,
+           MetadataValue{std::vector<unsigned char>(static_cast<const unsigned char*>(data),
+                                                    static_cast<const unsigned char*>(data) + size)});
+    publish(std::move(added));
 }
 
 
@@ -57,6 +86,10 @@ void Parametrization::update(const Message& msg) {
     const auto& md = msg.metadata();
     auto searchKey = md.find(PARAMETRIZATION_PAYLOAD_KEY);
 
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    // Payload and metadata go into a single layer, so that readers never see one without the other
+    BaseMetadata added;
     if (searchKey != md.end()) {
         auto& payload = msg.payload();
         if (msg.payload().size() == 0) {
@@ -65,32 +98,54 @@ void Parametrization::update(const Message& msg) {
                 << searchKey->second << "\" is specified but payload is empty.";
             throw MetadataException(oss.str(), Here());
         }
-        update(searchKey->second.get<std::string>(), payload.data(), payload.size());
+        const auto* data = static_cast<const unsigned char*>(payload.data());
+        update(added, searchKey->second.get<std::string>(),
+               MetadataValue{std::vector<unsigned char>(data, data + payload.size())});
     }
 
-    update(md);
+    for (const auto& kv : md) {
+        if (kv.first.value() != PARAMETRIZATION_PAYLOAD_KEY) {
+            update(added, kv.first, kv.second);
+        }
+    }
+    publish(std::move(added));
 }
 
 
-void Parametrization::update(const std::string& key, const MetadataValue& val) {
-    auto it = data_.find(key);
-    if (it == data_.end()) {
+void Parametrization::update(BaseMetadata& added, const BaseMetadata::KeyType& key, const MetadataValue& val) const {
+    const MetadataValue* known = nullptr;
+    if (auto it = find(key)) {
+        known = &(*it)->second;
+    }
+    else if (auto it = added.find(key); it != added.end()) {
+        known = &it->second;
+    }
+
+    if (!known) {
         eckit::Log::debug<LibMultio>() << "Parametrization :: " << key << ": " << val << std::endl;
-        data_.set(key, val);
+        added.set(key, val);
     }
-    else {
-        if (it->second != val) {
-            std::ostringstream oss;
-            oss << "Parametrization error. Key " << key << " already contains a different value: " << it->second
-                << " != " << val;
-            throw MetadataException(oss.str(), Here());
-        }
+    else if (*known != val) {
+        std::ostringstream oss;
+        oss << "Parametrization error. Key " << key << " already contains a different value: " << *known
+            << " != " << val;
+        throw MetadataException(oss.str(), Here());
+    }
+}
+
+
+void Parametrization::publish(BaseMetadata&& added) {
+    if (added.empty()) {
+        return;
     }
+    auto layer = std::make_unique<Layer>(Layer{std::move(added), std::move(head_)});
+    head_ = std::move(layer);
+    current_.store(head_.get(), std::memory_order_release);
 }
 
 
 void Parametrization::print(std::ostream& out) const {
-    out << "Parametrization :: " << data_;
+    out << "Parametrization :: " << get();
 }
 
 
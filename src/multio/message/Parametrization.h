@@ -1,6 +1,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 #include "multio/message/BaseMetadata.h"
 #include "multio/message/Message.h"
 
@@ -18,10 +24,17 @@ static std::string PARAMETRIZATION_PAYLOAD_KEY = "payloadKey";
  *             This singleton object is shared accross multiple multio instances (e.g. IFS and NEMO). Hence it is
  * assumed that all global key-value pairs of different models are exclusive to each other or contain the same value.
  *
+ *             Lookups happen on every metadata miss and must not contend with each other. The parametrization is
+ * therefore kept as a chain of immutable layers published through an atomic pointer: an update collects the key-value
+ * pairs it adds (or none of them if one is inconsistent) in a new layer on top of the current one. Updates which add
+ * nothing publish nothing, and updates are serialised by a mutex. Each value is stored once and never moves, so
+ * Metadata::find can hand out iterators to it - memory grows with the distinct key-value pairs, not with the number of
+ * updates. Layers dropped by clear() are retained until the singleton is destroyed for the same reason.
+ *
  */
 class Parametrization {
 public:
-    Parametrization() = default;
+    Parametrization();
 
     Parametrization(const Parametrization& rhs) = delete;
     Parametrization(Parametrization&& rhs) noexcept = delete;
@@ -31,7 +44,11 @@ public:
 
     static Parametrization& instance();
 
-    BaseMetadata& get();
+    // Copy of all current key-value pairs, does not see later updates
+    BaseMetadata get() const;
+
+    // Entry of a key, wait-free. Published entries are never modified
+    std::optional<BaseMetadata::ConstIterator> find(const BaseMetadata::KeyType& key) const;
 
     // Update with no payload but key value pairs - throws if a key already exists with a different value
     void update(const BaseMetadata&);
@@ -52,12 +69,24 @@ private:
         x.print(s);
         return s;
     }
-    void update(const std::string& key, const MetadataValue&);
+    // Adds a key-value pair to the next layer unless it is known - throws if it is known with a different value
+    void update(BaseMetadata& added, const BaseMetadata::KeyType& key, const MetadataValue&) const;
+
+    // Publishes the pairs added by an update as a new layer, the caller holds mutex_
+    void publish(BaseMetadata&& added);
+
+    struct Layer {
+        BaseMetadata values;
+        std::unique_ptr<Layer> previous;
+    };
 
-    // TODO use RW lock (maybe with atomic flag)
+    // Serialises writers, readers never lock
     mutable std::mutex mutex_;
 
-    BaseMetadata data_;
+    // Owns the published layers through Layer::previous
+    std::unique_ptr<Layer> head_;
+    std::vector<std::unique_ptr<Layer>> cleared_;
+    std::atomic<Layer*> current_{nullptr};
 };
 
 }  // namespace multio::message
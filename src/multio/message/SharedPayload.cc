@@ -74,6 +74,10 @@ void SharedPayload::acquire() {
     (*this) = this->moveOrCopy();
 }
 
+bool SharedPayload::isReference() const noexcept {
+    return std::holds_alternative<PayloadReference>(static_cast<const Base&>(*this));
+}
+
 void* SharedPayload::modifyData() {
     return util::visit(eckit::Overloaded{
                            [](std::shared_ptr<eckit::Buffer>& sharedBuf) -> void* { return sharedBuf->data(); },
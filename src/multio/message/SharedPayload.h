@@ -77,6 +77,9 @@ public:
     // Makes sure that this object is the only owner of the data and copy the data if it is not
     void acquire();
 
+    // True if the data is owned by someone else, e.g. the array passed to a write call
+    bool isReference() const noexcept;
+
     //----------------------------------------------------------------------------------------------------------------------
 
 
@@ -0,0 +1,133 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "AsyncDispatch.h"
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+
+#include "multio/LibMultio.h"
+
+namespace multio::server {
+
+AsyncDispatch::AsyncDispatch(Process process, std::size_t queueSize, std::size_t maxQueuedBytes) :
+    process_{std::move(process)}, maxQueuedBytes_{maxQueuedBytes}, queue_{queueSize} {
+    thread_ = std::thread([this]() { run(); });
+}
+
+AsyncDispatch::~AsyncDispatch() {
+    try {
+        drain();
+    }
+    catch (const std::exception& e) {
+        eckit::Log::error() << "AsyncDispatch: failure while draining the dispatch queue: " << e.what() << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+    consumerCv_.notify_one();
+    thread_.join();
+}
+
+void AsyncDispatch::push(message::Message msg) {
+    rethrowFailure();
+
+    const std::size_t size = msg.payload().size();
+    waitForProgress([&]() {
+        if (queue_.full()) {
+            return false;
+        }
+        // A single message exceeding the budget is still accepted when nothing else is in flight
+        const std::size_t queued = queuedBytes_.load();
+        return (maxQueuedBytes_ == 0) || (queued == 0) || (queued + size <= maxQueuedBytes_);
+    });
+    rethrowFailure();
+
+    queuedBytes_ += size;
+    const bool pushed = queue_.tryPush(msg);
+    ASSERT(pushed);
+    ++pushed_;
+
+    if (consumerWaiting_) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        consumerCv_.notify_one();
+    }
+}
+
+void AsyncDispatch::drain() {
+    waitForProgress([&]() { return processed_.load() == pushed_; });
+    rethrowFailure();
+}
+
+template <typename Predicate>
+void AsyncDispatch::waitForProgress(Predicate pred) {
+    if (pred()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock{mutex_};
+    producerWaiting_ = true;
+    producerCv_.wait(lock, [&]() { return failed_ || pred(); });
+    producerWaiting_ = false;
+}
+
+void AsyncDispatch::rethrowFailure() {
+    if (!failed_) {
+        return;
+    }
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        failure = std::move(failure_);
+        failure_ = nullptr;
+        failed_ = false;
+    }
+    std::rethrow_exception(failure);
+}
+
+void AsyncDispatch::run() {
+    while (true) {
+        auto msg = queue_.tryPop();
+        if (!msg) {
+            std::unique_lock<std::mutex> lock{mutex_};
+            consumerWaiting_ = true;
+            consumerCv_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+            consumerWaiting_ = false;
+            if (stop_ && queue_.empty()) {
+                return;
+            }
+            continue;
+        }
+
+        const std::size_t size = msg->payload().size();
+        if (!failed_) {
+            try {
+                process_(std::move(*msg));
+            }
+            catch (...) {
+                LOG_DEBUG_LIB(LibMultio) << "AsyncDispatch: failure on dispatch thread" << std::endl;
+                std::lock_guard<std::mutex> lock{mutex_};
+                failure_ = std::current_exception();
+                failed_ = true;
+            }
+        }
+
+        queuedBytes_ -= size;
+        ++processed_;
+
+        if (producerWaiting_) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            producerCv_.notify_one();
+        }
+    }
+}
+
+}  // namespace multio::server
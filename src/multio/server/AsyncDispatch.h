@@ -0,0 +1,80 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "multio/message/Message.h"
+#include "multio/util/SpscQueue.h"
+
+namespace multio::server {
+
+/**
+ * Runs the client plans on a dedicated progress thread, so that the model thread only pays for enqueuing a message.
+ *
+ * Messages must own their metadata and payload when pushed. Backpressure is applied by blocking `push` while either
+ * the queue is full or the payloads in flight exceed the byte budget. A failure on the progress thread is rethrown on
+ * the next call to `push` or `drain`; messages queued in between are discarded.
+ */
+class AsyncDispatch {
+public:
+    using Process = std::function<void(message::Message)>;
+
+    /// @param maxQueuedBytes Budget for payloads in flight, 0 means unbounded
+    AsyncDispatch(Process process, std::size_t queueSize, std::size_t maxQueuedBytes);
+
+    /// Drains the queue before stopping the progress thread
+    ~AsyncDispatch();
+
+    AsyncDispatch(const AsyncDispatch&) = delete;
+    AsyncDispatch& operator=(const AsyncDispatch&) = delete;
+
+    /// Called from a single producer thread
+    void push(message::Message msg);
+
+    /// Completion barrier: returns when all pushed messages have been processed
+    void drain();
+
+private:
+    void run();
+
+    template <typename Predicate>
+    void waitForProgress(Predicate pred);
+
+    void rethrowFailure();
+
+    const Process process_;
+    const std::size_t maxQueuedBytes_;
+
+    util::SpscQueue<message::Message> queue_;
+    std::atomic<std::size_t> queuedBytes_{0};
+    std::size_t pushed_ = 0;  // Only accessed by the producer
+    std::atomic<std::size_t> processed_{0};
+
+    std::mutex mutex_;
+    std::condition_variable consumerCv_;
+    std::condition_variable producerCv_;
+    std::atomic<bool> consumerWaiting_{false};
+    std::atomic<bool> producerWaiting_{false};
+    std::atomic<bool> stop_{false};
+
+    std::atomic<bool> failed_{false};
+    std::exception_ptr failure_;  // Guarded by mutex_
+
+    std::thread thread_;
+};
+
+}  // namespace multio::server
@@ -6,7 +6,10 @@
 
 #include "multio/LibMultio.h"
 #include "multio/action/Plan.h"
+#include "multio/action/PlanIndex.h"
 #include "multio/message/Parametrization.h"
+#include "multio/util/Metrics.h"
+#include "multio/util/TraceSpan.h"
 
 #include "multio/domain/Mappings.h"
 #include "multio/domain/Mask.h"
@@ -25,6 +28,7 @@ Dispatcher::Dispatcher(const config::ComponentConfiguration& compConf, eckit::Qu
     config::ComponentConfiguration::SubComponentConfigurations plans = compConf.subComponents("plans");
 
     plans_ = action::Plan::makePlans(compConf.parsedConfig().getSubConfigurations("plans"), compConf.multioConfig());
+    planIndex_ = std::make_unique<action::PlanIndex>(plans_);
 }
 
 util::FailureHandlerResponse Dispatcher::handleFailure(util::OnDispatchError t, const util::FailureContext& c,
@@ -37,11 +41,20 @@ Dispatcher::~Dispatcher() = default;
 
 void Dispatcher::dispatch() {
     util::ScopedTiming<> timer{timing_};
+
+    auto& metrics = util::Metrics::instance();
+    auto* depth = metrics.enabled()
+                    ? &metrics.gauge("multio_dispatch_queue_depth", "", "Messages waiting in the dispatch queue")
+                    : nullptr;
+
     withFailureHandling([&]() {
         try {
             message::Message msg;
             auto sz = queue_.pop(msg);
             while (sz >= 0) {
+                if (depth) {
+                    depth->set(sz);
+                }
                 handle(std::move(msg));
                 LOG_DEBUG_LIB(multio::LibMultio) << "Size of the dispatch queue: " << sz << std::endl;
                 sz = queue_.pop(msg);
@@ -55,6 +68,8 @@ void Dispatcher::dispatch() {
 }
 
 void Dispatcher::handle(message::Message msg) const {
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_DISPATCH, util::traceFieldKey(msg.metadata()));
+
     switch (msg.tag()) {
         case message::Message::Tag::Domain:
             domain::Mappings::instance().add(std::move(msg));
@@ -70,10 +85,8 @@ void Dispatcher::handle(message::Message msg) const {
             break;
 
         default:
-            // TODO add proper PlanExecuter that checks select paths befare...
-            for (const auto& plan : plans_) {
-                plan->process(msg);
-            }
+            // Only visit plans whose leading select can match
+            planIndex_->forEachCandidate(msg.metadata(), [&](action::Plan& plan) { plan.process(msg); });
     }
 }
 
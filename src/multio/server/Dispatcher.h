@@ -37,7 +37,8 @@ namespace multio {
 
 namespace action {
 class Plan;
-}
+class PlanIndex;
+}  // namespace action
 
 namespace server {
 
@@ -73,6 +74,7 @@ private:
 
     eckit::Queue<message::Message>& queue_;
     std::vector<std::unique_ptr<action::Plan>> plans_;
+    std::unique_ptr<action::PlanIndex> planIndex_;
 
     util::Timing<> timing_;
 };
@@ -26,7 +26,9 @@
 #include "multio/server/Dispatcher.h"
 #include "multio/transport/Transport.h"
 #include "multio/transport/TransportRegistry.h"
+#include "multio/util/Metrics.h"
 #include "multio/util/ScopedThread.h"
+#include "multio/util/TraceSpan.h"
 
 #ifdef MULTIO_SERVER_MEMORY_PROFILE_ENABLED
 
@@ -127,9 +129,21 @@ void Listener::start() {
 
     ScopedThread dpatchThread{std::thread{[&]() { dispatcher_->dispatch(); }}};
 
+    auto& metrics = util::Metrics::instance();
+    const util::FieldLatency receiveLatency{"", "receive"};
+    util::MetricsCounter* received = nullptr;
+    util::MetricsCounter* receivedBytes = nullptr;
+    if (metrics.enabled()) {
+        received = &metrics.counter("multio_received_messages", "", "Messages queued for dispatch");
+        receivedBytes = &metrics.counter("multio_received_bytes", "", "Payload bytes queued for dispatch");
+    }
+
     withFailureHandling([&]() {
         do {
-            Message msg = transport_.receive();
+            Message msg = [this]() {
+                MULTIO_TRACE_SPAN(util::MULTIO_SPAN_RECEIVE);
+                return transport_.receive();
+            }();
 
             switch (msg.tag()) {
                 case Message::Tag::Open:
@@ -157,6 +171,11 @@ void Listener::start() {
                 case Message::Tag::Field:
                     checkConnection(msg.source());
                     LOG_DEBUG_LIB(LibMultio) << "*** Message received: " << msg << std::endl;
+                    if (received) {
+                        received->add();
+                        receivedBytes->add(msg.size());
+                    }
+                    receiveLatency.record(msg.origin().time);
                     msgQueue_.emplace(std::move(msg));
                     break;
 
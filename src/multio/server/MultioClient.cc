@@ -14,6 +14,7 @@
 #include "multio/message/Message.h"
 #include "multio/message/Parametrization.h"
 #include "multio/transport/TransportRegistry.h"
+#include "multio/util/TraceSpan.h"
 
 using multio::message::Message;
 using multio::message::Peer;
@@ -84,6 +85,23 @@ void reportMemoryUsage() {
 auto last_report_time = std::chrono::system_clock::now();
 auto last_flush_time = std::chrono::system_clock::now();
 
+// Reports the memory usage and flushes the tracer when their periods have elapsed, called after each dispatch
+void profileMemoryUsage() {
+    const auto current_time = std::chrono::system_clock::now();
+    const auto elapsed_from_report = current_time - last_report_time;
+    const auto elapsed_from_flush = current_time - last_flush_time;
+
+    if (elapsed_from_report > tracerMemoryReportPeriod) {
+        reportMemoryUsage();
+        last_report_time = current_time;
+    }
+
+    if (elapsed_from_flush > tracerFlushPeriod) {
+        tracer.flushCurrentChunk();
+        last_flush_time = current_time;
+    }
+}
+
 }  // namespace
 
 #endif
@@ -129,6 +147,16 @@ MultioClient::MultioClient(const eckit::LocalConfiguration& conf, MultioConfigur
         planNames.insert(plan->name());
     }
 
+    planIndex_ = std::make_unique<action::PlanIndex>(plans_);
+
+    // Opt-in: run plans and transport on a progress thread instead of the calling (model) thread
+    if (conf.has("async-dispatch")) {
+        const auto asyncConf = conf.getSubConfiguration("async-dispatch");
+        asyncDispatch_ = std::make_unique<AsyncDispatch>([this](message::Message msg) { process(std::move(msg)); },
+                                                         asyncConf.getUnsigned("queue-size", 64),
+                                                         asyncConf.getUnsigned("max-queued-mb", 0) * 1024 * 1024);
+    }
+
     if (multioConfig().parsedConfig().has("active-matchers")) {
         for (const auto& m : multioConfig().parsedConfig().getSubConfigurations("active-matchers")) {
             std::map<std::string, std::set<std::string>> matches;
@@ -169,6 +197,9 @@ void MultioClient::openConnections() {
 }
 
 void MultioClient::closeConnections() {
+    if (asyncDispatch_) {
+        asyncDispatch_->drain();
+    }
     withFailureHandling([]() { transport::TransportRegistry::instance().closeConnections(); },
                         []() { return std::string("MultioClient::closeConnections"); });
 }
@@ -185,6 +216,65 @@ void MultioClient::dispatch(message::SharedMetadata metadata, const message::Pay
 }
 
 void MultioClient::dispatch(message::Message msg) {
+    if (msg.tag() == Message::Tag::Field && msg.origin().time == 0) {
+        msg.header().setOrigin(Message::Origin::now());
+    }
+
+    if (asyncDispatch_) {
+        // The caller may reuse its metadata and payload as soon as this returns. Acquiring is lazy for metadata,
+        // modifying it forces the copy if it is still shared with the caller.
+        msg.acquire();
+        msg.modifyMetadata();
+
+        const bool isFlush = (msg.tag() == message::Message::Tag::Flush);
+        asyncDispatch_->push(std::move(msg));
+        if (isFlush) {
+            // Flushes are completion barriers
+            asyncDispatch_->drain();
+        }
+    }
+    else {
+        process(std::move(msg));
+    }
+
+#ifdef MULTIO_CLIENT_MEMORY_PROFILE_ENABLED
+    profileMemoryUsage();
+#endif
+}
+
+void MultioClient::dispatch(std::vector<message::Message> batch) {
+    for (auto& msg : batch) {
+        ASSERT(msg.tag() == message::Message::Tag::Field);
+        if (msg.origin().time == 0) {
+            msg.header().setOrigin(Message::Origin::now());
+        }
+    }
+
+    if (asyncDispatch_) {
+        for (auto& msg : batch) {
+            msg.acquire();
+            msg.modifyMetadata();
+            asyncDispatch_->push(std::move(msg));
+        }
+    }
+    else {
+        withFailureHandling([&]() {
+            // Plans handle the whole batch one after the other, so each span covers one field in one plan
+            planIndex_->forEachCandidate(batch, [&](action::Plan& plan, const message::Message& msg) {
+                MULTIO_TRACE_SPAN(util::MULTIO_SPAN_DISPATCH, util::traceFieldKey(msg.metadata()));
+                plan.process(msg);
+            });
+        });
+    }
+
+#ifdef MULTIO_CLIENT_MEMORY_PROFILE_ENABLED
+    profileMemoryUsage();
+#endif
+}
+
+void MultioClient::process(message::Message msg) {
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_DISPATCH, util::traceFieldKey(msg.metadata()));
+
     withFailureHandling([&]() {
         if (msg.tag() == message::Message::Tag::Flush) {
             for (const auto& plan : plans_) {
@@ -200,27 +290,9 @@ void MultioClient::dispatch(message::Message msg) {
                 message::Parametrization::instance().update(msg);
             }
 
-            for (const auto& plan : plans_) {
-                plan->process(msg);
-            }
+            planIndex_->forEachCandidate(msg.metadata(), [&](action::Plan& plan) { plan.process(msg); });
         }
     });
-
-#ifdef MULTIO_CLIENT_MEMORY_PROFILE_ENABLED
-    const auto current_time = std::chrono::system_clock::now();
-    const auto elapsed_from_report = current_time - last_report_time;
-    const auto elapsed_from_flush = current_time - last_flush_time;
-
-    if (elapsed_from_report > tracerMemoryReportPeriod) {
-        reportMemoryUsage();
-        last_report_time = current_time;
-    }
-
-    if (elapsed_from_flush > tracerFlushPeriod) {
-        tracer.flushCurrentChunk();
-        last_flush_time = current_time;
-    }
-#endif
 }
 
 bool MultioClient::isFieldMatched(const message::Metadata& metadata) const {
@@ -14,12 +14,15 @@
 #include <vector>
 
 #include "multio/action/Plan.h"
+#include "multio/action/PlanIndex.h"
 #include "multio/config/ComponentConfiguration.h"
 #include "multio/message/Message.h"
 #include "multio/message/Metadata.h"
 #include "multio/message/MetadataMatcher.h"
 #include "multio/util/FailureHandling.h"
 
+#include "multio/server/AsyncDispatch.h"
+
 #include "eckit/log/Statistics.h"
 
 namespace eckit {
@@ -70,6 +73,9 @@ public:
 
     void dispatch(message::Message msg);
 
+    /// Dispatches a batch of fields. Plans are traversed once per batch rather than once per field.
+    void dispatch(std::vector<message::Message> batch);
+
     bool isFieldMatched(const message::Metadata& matcher) const;
 
     util::FailureHandlerResponse handleFailure(util::OnClientError, const util::FailureContext&,
@@ -78,7 +84,12 @@ public:
 private:
     MultioClient(const eckit::LocalConfiguration& conf, MultioConfiguration&& multioConf);
 
+    void process(message::Message msg);
+
     std::vector<std::unique_ptr<action::Plan>> plans_;
+    std::unique_ptr<action::PlanIndex> planIndex_;
+    // Declared after the plans, so that the dispatch thread is drained and joined before they are destroyed
+    std::unique_ptr<AsyncDispatch> asyncDispatch_;
     message::match::MatchReduce activeSelectors_{message::match::Reduce::Or};
 
     eckit::Timing totClientTiming_;
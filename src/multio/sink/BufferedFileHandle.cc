@@ -0,0 +1,270 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/sink/BufferedFileHandle.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <ostream>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Bytes.h"
+#include "eckit/log/Log.h"
+
+
+namespace multio::sink {
+
+namespace {
+
+std::size_t roundUp(std::size_t n, std::size_t a) {
+    return ((n + a - 1) / a) * a;
+}
+
+void pwriteAll(int fd, const char* data, std::size_t length, off_t offset, const eckit::PathName& path) {
+    while (length > 0) {
+        auto written = ::pwrite(fd, data, length, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw eckit::FailedSystemCall("pwrite " + path.asString(), Here());
+        }
+        data += written;
+        length -= static_cast<std::size_t>(written);
+        offset += written;
+    }
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+BufferedFileHandle::BufferedFileHandle(const eckit::PathName& path, std::size_t bufferSize, bool direct) :
+    path_{path}, capacity_{roundUp(std::max<std::size_t>(bufferSize, 1), alignment)}, direct_{direct} {
+#ifndef O_DIRECT
+    if (direct_) {
+        throw eckit::UserError("Direct I/O is not supported on this platform", Here());
+    }
+#endif
+    for (auto& b : buffers_) {
+        b.reset(static_cast<char*>(std::aligned_alloc(alignment, capacity_)));
+        if (!b) {
+            throw std::bad_alloc();
+        }
+    }
+}
+
+BufferedFileHandle::~BufferedFileHandle() {
+    try {
+        close();
+    }
+    catch (const std::exception& e) {
+        eckit::Log::error() << "Closing " << *this << " failed: " << e.what() << std::endl;
+    }
+}
+
+void BufferedFileHandle::openForWrite(const eckit::Length&) {
+    open(O_WRONLY | O_TRUNC);
+}
+
+void BufferedFileHandle::openForAppend(const eckit::Length&) {
+    // Direct I/O reads back the partial block at the end of the file
+    open(O_RDWR);
+
+    struct stat st;
+    if (::fstat(fd_, &st) < 0) {
+        throw eckit::FailedSystemCall("fstat " + path_.asString(), Here());
+    }
+
+    fill_ = direct_ ? static_cast<std::size_t>(st.st_size) % alignment : 0;
+    offset_ = st.st_size - static_cast<off_t>(fill_);
+    if (fill_ > 0) {
+        auto n = ::pread(fd_, buffer(current_), alignment, offset_);
+        if (n < static_cast<ssize_t>(fill_)) {
+            throw eckit::FailedSystemCall("pread " + path_.asString(), Here());
+        }
+    }
+}
+
+void BufferedFileHandle::open(int flags) {
+    ASSERT(fd_ < 0);
+
+    flags |= O_CREAT;
+#ifdef O_DIRECT
+    if (direct_) {
+        flags |= O_DIRECT;
+    }
+#endif
+
+    fd_ = ::open(path_.localPath(), flags, 0644);
+    if (fd_ < 0) {
+        throw eckit::FailedSystemCall("open " + path_.asString(), Here());
+    }
+
+    current_ = 0;
+    fill_ = 0;
+    offset_ = 0;
+    stop_ = false;
+    thread_ = std::thread{&BufferedFileHandle::run, this};
+}
+
+long BufferedFileHandle::write(const void* data, long length) {
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        rethrow(lock);
+    }
+
+    const auto* p = static_cast<const char*>(data);
+    auto remaining = static_cast<std::size_t>(length);
+    while (remaining > 0) {
+        const auto n = std::min(remaining, capacity_ - fill_);
+        std::memcpy(buffer(current_) + fill_, p, n);
+        fill_ += n;
+        p += n;
+        remaining -= n;
+
+        if (fill_ == capacity_) {
+            submit(fill_);
+        }
+    }
+    return length;
+}
+
+void BufferedFileHandle::flush() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    // Direct I/O can only write whole blocks, the tail is written separately below
+    const auto length = direct_ ? (fill_ / alignment) * alignment : fill_;
+    if (length > 0) {
+        submit(length);
+    }
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    waitIdle(lock);
+
+    if (fill_ > 0) {
+        const auto padded = roundUp(fill_, alignment);
+        std::memset(buffer(current_) + fill_, 0, padded - fill_);
+        pwriteAll(fd_, buffer(current_), padded, offset_, path_);
+        if (::ftruncate(fd_, offset_ + static_cast<off_t>(fill_)) < 0) {
+            throw eckit::FailedSystemCall("ftruncate " + path_.asString(), Here());
+        }
+    }
+
+    rethrow(lock);
+}
+
+void BufferedFileHandle::close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    std::exception_ptr error;
+    try {
+        flush();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+        cv_.notify_all();
+    }
+    thread_.join();
+
+    const auto rc = ::close(fd_);
+    fd_ = -1;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (rc < 0) {
+        throw eckit::FailedSystemCall("close " + path_.asString(), Here());
+    }
+}
+
+void BufferedFileHandle::submit(std::size_t length) {
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    // The other buffer is free once its previous job is done
+    waitIdle(lock);
+
+    const auto next = 1 - current_;
+    const auto keep = fill_ - length;
+    if (keep > 0) {
+        std::memcpy(buffer(next), buffer(current_) + length, keep);
+    }
+
+    job_ = Job{current_, length, offset_};
+    cv_.notify_all();
+
+    offset_ += static_cast<off_t>(length);
+    current_ = next;
+    fill_ = keep;
+}
+
+void BufferedFileHandle::waitIdle(std::unique_lock<std::mutex>& lock) {
+    cv_.wait(lock, [this]() { return !job_; });
+}
+
+void BufferedFileHandle::rethrow(std::unique_lock<std::mutex>&) {
+    if (error_) {
+        std::exception_ptr error;
+        std::swap(error, error_);
+        std::rethrow_exception(error);
+    }
+}
+
+void BufferedFileHandle::run() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (;;) {
+        cv_.wait(lock, [this]() { return job_ || stop_; });
+        if (!job_) {
+            return;
+        }
+
+        const auto job = *job_;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            pwriteAll(fd_, buffer(job.buffer), job.length, job.offset, path_);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error && !error_) {
+            error_ = error;
+        }
+        job_.reset();
+        cv_.notify_all();
+    }
+}
+
+void BufferedFileHandle::print(std::ostream& os) const {
+    os << "BufferedFileHandle[path=" << path_ << ",buffer=" << eckit::Bytes(capacity_) << (direct_ ? ",direct" : "")
+       << "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
@@ -0,0 +1,115 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/DataHandle.h"
+
+namespace multio::sink {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Write-only file handle that stages data in large buffers and writes them with few, big sequential writes.
+ *
+ * There are two page-aligned buffers: while the caller fills one, a background thread writes the other, so that the
+ * I/O overlaps with the accumulation of the next chunk. Writes only block when both buffers are in use.
+ *
+ * With direct I/O the file is opened with O_DIRECT and bypasses the page cache. Full buffers are aligned already. On
+ * flush, the unaligned tail is written padded to a whole block and the file is truncated to its real size; the tail
+ * stays buffered and is rewritten together with the data that follows.
+ *
+ * Errors of the background thread are rethrown by the next write, flush or close.
+ */
+class BufferedFileHandle final : public eckit::DataHandle {
+public:
+    static constexpr std::size_t alignment = 4096;
+
+    BufferedFileHandle(const eckit::PathName& path, std::size_t bufferSize, bool direct);
+
+    ~BufferedFileHandle() override;
+
+    BufferedFileHandle(const BufferedFileHandle&) = delete;
+    BufferedFileHandle& operator=(const BufferedFileHandle&) = delete;
+
+    void openForWrite(const eckit::Length&) override;
+    void openForAppend(const eckit::Length&) override;
+
+    long write(const void* data, long length) override;
+
+    /// Writes all buffered data to the file
+    void flush() override;
+
+    void close() override;
+
+private:  // methods
+    void print(std::ostream&) const override;
+
+    void open(int flags);
+
+    // Hands the first length bytes of the current buffer to the background thread and carries the rest over
+    void submit(std::size_t length);
+
+    void waitIdle(std::unique_lock<std::mutex>&);
+    void rethrow(std::unique_lock<std::mutex>&);
+
+    void run();
+
+    char* buffer(std::size_t i) const { return buffers_[i].get(); }
+
+private:  // members
+    struct Free {
+        void operator()(char* p) const { std::free(p); }
+    };
+
+    struct Job {
+        std::size_t buffer;
+        std::size_t length;
+        off_t offset;
+    };
+
+    eckit::PathName path_;
+    std::size_t capacity_;
+    bool direct_;
+
+    int fd_ = -1;
+
+    std::unique_ptr<char, Free> buffers_[2];
+    std::size_t current_ = 0;
+    std::size_t fill_ = 0;
+
+    // File offset of the start of the current buffer
+    off_t offset_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::optional<Job> job_;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    std::thread thread_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
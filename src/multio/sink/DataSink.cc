@@ -93,8 +93,14 @@ bool DataSink::ready() const {
     return true;  // default for synchronous sinks
 }
 
+void DataSink::write(const message::Message& message) {
+    write(message::to_eckit_message(message));
+}
+
 void DataSink::flush() {}
 
+void DataSink::sync() {}
+
 void DataSink::setId(int id) {
     id_ = id;
 }
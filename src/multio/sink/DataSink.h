@@ -23,6 +23,7 @@
 #include "eckit/memory/NonCopyable.h"
 #include "eckit/message/Message.h"
 #include "multio/config/ComponentConfiguration.h"
+#include "multio/message/Message.h"
 
 namespace multio::sink {
 
@@ -38,9 +39,17 @@ public:  // methods
 
     virtual void write(eckit::message::Message message) = 0;
 
+    /// Writes the payload of a multio message. By default it is wrapped into an eckit message; sinks that can use the
+    /// payload and metadata directly override this to skip the conversion
+    virtual void write(const message::Message& message);
+
     /// No further writes to this sink
     virtual void flush();
 
+    /// Waits until all data flushed so far is visible to readers. Sinks that flush in the background override this,
+    /// for all others flush() returns when the data is visible
+    virtual void sync();
+
     /// Set the datasink ID that is used by other classes to identify this one.
     /// In particular, it labels which sink within a MultIO this one is.
     void setId(int id);
@@ -14,10 +14,16 @@
 #include <fstream>
 #include <iosfwd>
 
+#include "multio/sink/BufferedFileHandle.h"
 #include "multio/sink/DataSink.h"
 #include "multio/sink/FileSink.h"
 #include "multio/util/logfile_name.h"
 
+#ifdef MULTIO_IO_URING_ENABLED
+#include "multio/sink/UringFileHandle.h"
+#endif
+
+#include "eckit/exception/Exceptions.h"
 #include "eckit/io/DataHandle.h"
 
 using namespace eckit;
@@ -39,11 +45,32 @@ std::string create_path(const config::ComponentConfiguration& compConf) {
     }
     return expanded_path;
 }
+
+// With "io-uring" set, data is written asynchronously through io_uring. With "buffer-size" (bytes) or "direct" set,
+// data is staged in large buffers and written by a background thread
+std::unique_ptr<eckit::DataHandle> create_handle(const config::ComponentConfiguration& compConf,
+                                                 const eckit::PathName& path) {
+    const auto& cfg = compConf.parsedConfig();
+    if (cfg.getBool("io-uring", false)) {
+#ifdef MULTIO_IO_URING_ENABLED
+        return std::make_unique<UringFileHandle>(path);
+#else
+        throw eckit::UserError("FileSink: multio is built without io_uring support (IO_URING feature)", Here());
+#endif
+    }
+
+    const auto direct = cfg.getBool("direct", false);
+    const auto bufferSize = cfg.getUnsigned("buffer-size", direct ? 64 * 1024 * 1024 : 0);
+    if (bufferSize > 0) {
+        return std::make_unique<BufferedFileHandle>(path, bufferSize, direct);
+    }
+    return std::unique_ptr<eckit::DataHandle>(path.fileHandle(false));
+}
 }  // namespace
 
 
 FileSink::FileSink(const config::ComponentConfiguration& compConf) :
-    DataSink(compConf), path_{create_path(compConf)}, handle_(path_.fileHandle(false)) {
+    DataSink(compConf), path_{create_path(compConf)}, handle_(create_handle(compConf, path_)) {
     if (compConf.parsedConfig().getBool("append", false)) {
         handle_->openForAppend(0);
     }
@@ -61,10 +88,16 @@ void FileSink::write(eckit::message::Message msg) {
     msg.write(*handle_);
 }
 
+void FileSink::write(const message::Message& msg) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handle_->write(msg.payload().data(), static_cast<long>(msg.size()));
+}
+
 void FileSink::flush() {
     eckit::Log::info() << "Flushing ";
     print(eckit::Log::info());
     eckit::Log::info() << std::endl;
+    std::lock_guard<std::mutex> lock(mutex_);
     handle_->flush();
 }
 
@@ -41,8 +41,12 @@ public:
     ~FileSink() override;
 
 private:  // methods
+    using DataSink::write;
+
     void write(eckit::message::Message msg) override;
 
+    void write(const message::Message& msg) override;
+
     void flush() override;
 
     void print(std::ostream&) const override;
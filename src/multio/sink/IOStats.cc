@@ -12,6 +12,7 @@
 /// @author Simon Smart
 /// @date Dec 2015
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 
@@ -35,6 +36,9 @@ namespace multio::sink {
 ///
 ///       Within the MultIO, all reads/writes/etc. are locked
 ///         --> locking occurs at a higher level than this!
+///
+///       The statistics of an asynchronous sink are only updated by its writer thread, and only reported once
+///       that thread is idle.
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -50,7 +54,12 @@ IOStats::IOStats(const std::string& prefix) :
     sumBytesWrittenSquared_(0),
     sumWriteTimesSquared_(0),
     numFlush_(0),
-    sumFlushTimesSquared_(0) {
+    sumFlushTimesSquared_(0),
+    numQueued_(0),
+    sumQueueTimesSquared_(0),
+    numQueueDepths_(0),
+    sumQueueDepths_(0),
+    maxQueueDepth_(0) {
 
     if (!prefix_.empty())
         prefix_ += std::string(" ");
@@ -105,6 +114,22 @@ void IOStats::logFlush(Timer& timer) {
 }
 
 
+void IOStats::logQueueDelay(double seconds) {
+
+    numQueued_++;
+    queueTiming_.elapsed_ += seconds;
+    sumQueueTimesSquared_ += seconds * seconds;
+}
+
+
+void IOStats::logQueueDepth(size_t depth) {
+
+    numQueueDepths_++;
+    sumQueueDepths_ += depth;
+    maxQueueDepth_ = std::max(maxQueueDepth_, depth);
+}
+
+
 void IOStats::report(std::ostream& s) const {
 
     // Write statistics
@@ -125,6 +150,18 @@ void IOStats::report(std::ostream& s) const {
 
     reportCount(s, "num flush", numFlush_);
     reportTimes(s, "flush time", numFlush_, flushTiming_, sumFlushTimesSquared_);
+
+    // Time spent waiting in the queue of an asynchronous sink
+
+    if (numQueued_ != 0) {
+        reportTimes(s, "queue delay", numQueued_, queueTiming_, sumQueueTimesSquared_);
+    }
+
+    if (numQueueDepths_ != 0) {
+        std::string lbl = "queue depth (avg, max)";
+        s << prefix_ << lbl << std::setw(FORMAT_WIDTH - lbl.length()) << " : "
+          << (static_cast<double>(sumQueueDepths_) / numQueueDepths_) << ", " << maxQueueDepth_ << std::endl;
+    }
 }
 
 
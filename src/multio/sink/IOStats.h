@@ -39,6 +39,8 @@ public:
     void logRead(const eckit::Length& size, eckit::Timer& timer);
     void logWrite(const eckit::Length& size, eckit::Timer& timer);
     void logFlush(eckit::Timer& timer);
+    void logQueueDelay(double seconds);
+    void logQueueDepth(size_t depth);
 
 private:  // methods
     void print(std::ostream& s) const;
@@ -70,6 +72,14 @@ private:  // members
     eckit::Timing flushTiming_;
     double sumFlushTimesSquared_;
 
+    size_t numQueued_;
+    eckit::Timing queueTiming_;
+    double sumQueueTimesSquared_;
+
+    size_t numQueueDepths_;
+    size_t sumQueueDepths_;
+    size_t maxQueueDepth_;
+
 private:  // methods
     friend std::ostream& operator<<(std::ostream& s, const IOStats& p) {
         p.print(s);
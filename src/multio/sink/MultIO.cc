@@ -16,15 +16,21 @@
 
 #include <sys/types.h>
 #include <unistd.h>
+#include <exception>
 #include <functional>
+#include <sstream>
+#include <type_traits>
+#include <variant>
 
 #include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
 #include "eckit/runtime/Main.h"
 #include "eckit/utils/Translator.h"
 #include "eckit/value/Value.h"
 
 
 #include <multio/LibMultio.h>
+#include <multio/sink/SinkWriter.h>
 #include <multio/util/Substitution.h>
 
 using namespace eckit;
@@ -46,6 +52,21 @@ public:
         fun_(timer_);
     }
 };
+
+// Queued messages are written after the call has returned. A payload that refers to the caller's array, as passed to
+// multio_write_field, is copied; owned payloads are shared
+message::Message queued(const message::Message& msg) {
+    message::Message copy{msg};
+    if (copy.payload().isReference()) {
+        copy.acquirePayload();
+    }
+    return copy;
+}
+
+const eckit::message::Message& queued(const eckit::message::Message& msg) {
+    return msg;
+}
+
 }  // namespace
 
 //--------------------------------------------------------------------------------------------------
@@ -70,10 +91,36 @@ MultIO::MultIO(const ComponentConfiguration& compConf) :
                 ->setId(sinkId);
         }
     }
+
+    if (compConf.parsedConfig().getBool("async", sinks_.size() > 1)) {
+        const auto capacity = compConf.parsedConfig().getUnsigned("queue-size", 16);
+        for (const auto& sink : sinks_) {
+            std::ostringstream prefix;
+            prefix << "Multio " << Main::hostname() << ":" << ::getpid() << " sink " << sink->id();
+            auto* s = sink.get();
+            writers_.emplace_back(std::make_unique<SinkWriter>(
+                [s](SinkWriter::Item msg) { std::visit([s](auto& m) { s->write(std::move(m)); }, msg); },
+                [s]() { s->flush(); }, capacity, prefix.str()));
+        }
+    }
+}
+
+MultIO::~MultIO() {
+    // Pending writes complete before the triggers issue their final events
+    for (const auto& writer : writers_) {
+        try {
+            writer->wait();
+        }
+        catch (const std::exception& e) {
+            eckit::Log::error() << "MultIO: writing failed: " << e.what() << std::endl;
+        }
+    }
+    writers_.clear();
 }
 
 bool MultIO::ready() const {
     std::lock_guard<std::mutex> lock(mutex_);
+    wait();
 
     decltype(sinks_)::const_iterator it = sinks_.begin();
     decltype(sinks_)::const_iterator end = sinks_.end();
@@ -86,20 +133,53 @@ bool MultIO::ready() const {
 }
 
 void MultIO::write(eckit::message::Message message) {
+    writeAll(message, message.length());
+}
+
+void MultIO::write(const message::Message& message) {
+    writeAll(message, message.size());
+}
+
+template <typename Msg>
+void MultIO::writeAll(const Msg& message, std::size_t length) {
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    StatsTimer stTimer{timer_, std::bind(&IOStats::logWrite, &stats_, message.length(), _1)};
-    for (const auto& sink : sinks_) {
-        sink->write(message);
+    StatsTimer stTimer{timer_, std::bind(&IOStats::logWrite, &stats_, length, _1)};
+    if (writers_.empty()) {
+        for (const auto& sink : sinks_) {
+            sink->write(message);
+        }
+    }
+    else {
+        const auto& msg = queued(message);
+        for (const auto& writer : writers_) {
+            writer->write(msg);
+        }
+        if (!trigger_.empty()) {
+            // Events announce that the data is written
+            wait();
+        }
     }
 
-    LOG_DEBUG_LIB(LibMultio) << "Trigger events for message " << message << std::endl;
+    if (!trigger_.empty()) {
+        LOG_DEBUG_LIB(LibMultio) << "Trigger events for message " << message << std::endl;
 
-    trigger_.events(message);
+        if constexpr (std::is_same_v<Msg, eckit::message::Message>) {
+            trigger_.events(message);
+        }
+        else {
+            trigger_.events(message::to_eckit_message(message));
+        }
+    }
 }
 
 void MultIO::trigger(const eckit::StringDict& metadata) const {
+    {
+        // Notifications follow a flush and announce that its data can be read
+        std::lock_guard<std::mutex> lock(mutex_);
+        syncAll();
+    }
     trigger_.events(metadata);
 }
 
@@ -107,13 +187,55 @@ void MultIO::flush() {
     std::lock_guard<std::mutex> lock(mutex_);
 
     StatsTimer stTimer{timer_, std::bind(&IOStats::logFlush, &stats_, _1)};
+    if (writers_.empty()) {
+        for (const auto& sink : sinks_) {
+            sink->flush();
+        }
+    }
+    else {
+        for (const auto& writer : writers_) {
+            writer->flush();
+        }
+        wait();
+    }
+}
+
+void MultIO::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncAll();
+}
+
+void MultIO::syncAll() const {
+    wait();
     for (const auto& sink : sinks_) {
-        sink->flush();
+        sink->sync();
+    }
+}
+
+void MultIO::wait() const {
+    std::exception_ptr error;
+    for (const auto& writer : writers_) {
+        try {
+            writer->wait();
+        }
+        catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
 }
 
 void MultIO::report(std::ostream& s) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wait();
     stats_.report(s);
+    for (const auto& writer : writers_) {
+        writer->report(s);
+    }
 }
 
 void MultIO::print(std::ostream& os) const {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -33,20 +34,36 @@ namespace multio::sink {
 
 using config::ComponentConfiguration;
 
+class SinkWriter;
+
 //----------------------------------------------------------------------------------------------------------------------
 
+/// Writes every message to all configured sinks.
+///
+/// With "async" enabled (the default with more than one sink), each sink is written by its own thread from a bounded
+/// queue of "queue-size" messages, so that a slow sink does not hold up the others. Each sink still sees the messages
+/// in order, flush() waits until all sinks have written and flushed everything, and errors of a sink are rethrown by
+/// the next write or flush. If triggers are configured, each write waits until all sinks have written the message before
+/// its events are fired, so events only ever announce written data. trigger() also waits for sinks that flush in the
+/// background, e.g. an asynchronous FDB5Sink, so that notified data is visible to readers.
 class MultIO final : public DataSink {
 public:
     explicit MultIO(const ComponentConfiguration& config);
 
-    ~MultIO() override = default;
+    ~MultIO() override;
 
     bool ready() const override;
 
+    using DataSink::write;
+
     void write(eckit::message::Message message) override;
 
+    void write(const message::Message& message) override;
+
     void flush() override;
 
+    void sync() override;
+
     void trigger(const eckit::StringDict& metadata) const;
 
     void report(std::ostream&);
@@ -54,11 +71,23 @@ public:
 protected:  // methods
     void print(std::ostream&) const override;
 
+    // Waits until the asynchronous sinks have written all queued messages
+    void wait() const;
+
+    // Waits until all sinks have written the queued messages and made flushed data visible, the caller holds mutex_
+    void syncAll() const;
+
+    template <typename Msg>
+    void writeAll(const Msg& message, std::size_t length);
+
 protected:  // members
     IOStats stats_;
 
     std::vector<std::unique_ptr<DataSink>> sinks_;
 
+    // One per sink if asynchronous, otherwise empty. Destroyed before the sinks they write to
+    std::vector<std::unique_ptr<SinkWriter>> writers_;
+
     Trigger trigger_;
 
     mutable std::mutex mutex_;
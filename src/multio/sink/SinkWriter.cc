@@ -0,0 +1,155 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/sink/SinkWriter.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace multio::sink {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+SinkWriter::SinkWriter(WriteFunction write, FlushFunction flush, std::size_t capacity,
+                       const std::string& statsPrefix) :
+    write_{std::move(write)},
+    flush_{std::move(flush)},
+    capacity_{capacity},
+    stats_{statsPrefix},
+    thread_{&SinkWriter::run, this} {}
+
+SinkWriter::~SinkWriter() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+        notEmpty_.notify_one();
+    }
+    thread_.join();
+}
+
+void SinkWriter::write(Item message) {
+    push(Task{false, std::move(message), Clock::now()});
+}
+
+SinkWriter::Ticket SinkWriter::flush() {
+    push(Task{true, {}, Clock::now()});
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    return flushesQueued_;
+}
+
+void SinkWriter::waitFlushed(Ticket ticket) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this, ticket]() { return flushesDone_ >= ticket; });
+    rethrow(lock);
+}
+
+void SinkWriter::wait() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    rethrow(lock);
+}
+
+void SinkWriter::report(std::ostream& s) const {
+    stats_.report(s);
+}
+
+void SinkWriter::push(Task task) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    rethrow(lock);
+    notFull_.wait(lock, [this]() { return queue_.size() < capacity_; });
+    if (task.flush) {
+        ++flushesQueued_;
+    }
+    queue_.push_back(std::move(task));
+    ++pending_;
+    notEmpty_.notify_one();
+}
+
+void SinkWriter::rethrow(std::unique_lock<std::mutex>&) {
+    if (error_) {
+        std::exception_ptr error;
+        std::swap(error, error_);
+        std::rethrow_exception(error);
+    }
+}
+
+void SinkWriter::run() {
+    std::vector<Task> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            notEmpty_.wait(lock, [this]() { return !queue_.empty() || stop_; });
+            if (queue_.empty()) {
+                return;
+            }
+
+            batch.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(queue_.end()));
+            queue_.clear();
+            notFull_.notify_all();
+        }
+
+        stats_.logQueueDepth(batch.size());
+
+        for (auto& task : batch) {
+            std::exception_ptr error;
+            try {
+                process(task);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (error && !error_) {
+                error_ = error;
+            }
+            if (task.flush) {
+                ++flushesDone_;
+            }
+            if ((--pending_ == 0) || task.flush) {
+                done_.notify_all();
+            }
+        }
+        batch.clear();
+    }
+}
+
+void SinkWriter::process(Task& task) {
+    stats_.logQueueDelay(std::chrono::duration<double>(Clock::now() - task.queued).count());
+
+    timer_.start();
+    if (task.flush) {
+        flush_();
+        timer_.stop();
+        stats_.logFlush(timer_);
+    }
+    else {
+        const auto length = std::visit(
+            [](const auto& m) -> std::size_t {
+                if constexpr (std::is_same_v<std::decay_t<decltype(m)>, eckit::message::Message>) {
+                    return m.length();
+                }
+                else {
+                    return m.size();
+                }
+            },
+            task.message);
+        write_(std::move(task.message));
+        timer_.stop();
+        stats_.logWrite(length, timer_);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
@@ -0,0 +1,113 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+
+#include "eckit/log/Timer.h"
+#include "eckit/message/Message.h"
+
+#include "multio/message/Message.h"
+#include "multio/sink/IOStats.h"
+
+namespace multio::sink {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Writes messages from a dedicated thread, fed by a bounded queue. Writes and flushes are processed in the order they
+ * are queued. The thread takes all queued tasks at once, so a burst of messages is handled in one cycle.
+ *
+ * Errors of the thread are rethrown on the caller's side by the next write or wait. On destruction all queued tasks
+ * are processed before the thread stops.
+ */
+class SinkWriter {
+public:
+    using Item = std::variant<eckit::message::Message, message::Message>;
+    using WriteFunction = std::function<void(Item)>;
+    using FlushFunction = std::function<void()>;
+    using Ticket = std::uint64_t;
+
+    SinkWriter(WriteFunction write, FlushFunction flush, std::size_t capacity, const std::string& statsPrefix);
+
+    ~SinkWriter();
+
+    SinkWriter(const SinkWriter&) = delete;
+    SinkWriter& operator=(const SinkWriter&) = delete;
+
+    /// Queues a message, blocks while the queue is full
+    void write(Item message);
+
+    /// Queues a flush without waiting for it. The ticket identifies the flush for waitFlushed()
+    Ticket flush();
+
+    /// Waits until the flush with the given ticket is done and rethrows the first error since the last call
+    void waitFlushed(Ticket ticket);
+
+    /// Waits until all queued tasks are done and rethrows the first error since the last call
+    void wait();
+
+    /// Reports write, flush and queueing statistics. Only consistent while the writer is idle
+    void report(std::ostream& s) const;
+
+private:  // methods
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        bool flush;
+        Item message;
+        Clock::time_point queued;
+    };
+
+    void push(Task task);
+
+    void rethrow(std::unique_lock<std::mutex>&);
+
+    void run();
+
+    void process(Task& task);
+
+private:  // members
+    WriteFunction write_;
+    FlushFunction flush_;
+    const std::size_t capacity_;
+
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::condition_variable done_;
+    std::deque<Task> queue_;
+    std::size_t pending_ = 0;  // Queued or being processed
+    Ticket flushesQueued_ = 0;
+    Ticket flushesDone_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    // Only used by the thread
+    IOStats stats_;
+    eckit::Timer timer_;
+
+    std::thread thread_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
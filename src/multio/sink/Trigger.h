@@ -45,6 +45,8 @@ public:  // methods
     void events(const eckit::StringDict& metadata) const;
     void events(eckit::message::Message message) const;
 
+    bool empty() const { return triggers_.empty(); }
+
 private:  // methods
     void print(std::ostream&) const;
 
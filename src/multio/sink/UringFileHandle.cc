@@ -0,0 +1,412 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/sink/UringFileHandle.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/Resource.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+
+#include "multio/LibMultio.h"
+
+
+namespace multio::sink {
+
+namespace {
+
+int uringSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+template <typename T>
+T* offsetPointer(void* base, std::size_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// The ring shared by all handles. Submissions are serialised by a mutex, completions are reaped by one thread.
+class Ring {
+public:
+    static Ring& instance() {
+        static Ring ring{eckit::Resource<size_t>("multioUringQueueDepth;$MULTIO_URING_QUEUE_DEPTH", 64),
+                         eckit::Resource<size_t>("multioUringBufferSize;$MULTIO_URING_BUFFER_SIZE", 1024 * 1024)};
+        return ring;
+    }
+
+    std::size_t bufferSize() const { return bufferSize_; }
+
+    /// Copies the data into a free buffer and queues its write at the given offset
+    void write(UringFileHandle::File& file, const char* data, std::size_t length, off_t offset) {
+        ASSERT(length <= bufferSize_);
+
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        // Backpressure: wait for a completion if all buffers are in flight
+        cv_.wait(lock, [this]() { return !freeBuffers_.empty(); });
+        const auto b = freeBuffers_.back();
+        freeBuffers_.pop_back();
+        ++file.pending;
+
+        lock.unlock();
+        std::memcpy(buffer(b), data, length);
+        lock.lock();
+
+        auto& request = requests_[b];
+        request = Request{&file, b, length, offset, 0};
+        try {
+            submit(request);
+        }
+        catch (...) {
+            release(request);
+            throw;
+        }
+    }
+
+    /// Waits until all writes of the file are complete, throws if one of them failed
+    void wait(UringFileHandle::File& file) {
+        std::unique_lock<std::mutex> lock{mutex_};
+        cv_.wait(lock, [&file]() { return file.pending == 0; });
+        if (file.error != 0) {
+            errno = std::exchange(file.error, 0);
+            throw eckit::FailedSystemCall("io_uring write", Here());
+        }
+    }
+
+private:
+    struct Request {
+        UringFileHandle::File* file;
+        std::size_t buffer;
+        std::size_t length;
+        off_t offset;
+        std::size_t done;
+    };
+
+    Ring(std::size_t depth, std::size_t bufferSize) :
+        bufferSize_{bufferSize}, memory_{std::aligned_alloc(4096, ((depth * bufferSize + 4095) / 4096) * 4096)} {
+        if (!memory_) {
+            throw std::bad_alloc();
+        }
+
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = uringSetup(static_cast<unsigned>(depth), &params);
+        if (fd_ < 0) {
+            throw eckit::FailedSystemCall("io_uring_setup", Here());
+        }
+
+        sqSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            sqSize_ = cqSize_ = std::max(sqSize_, cqSize_);
+        }
+
+        sq_ = map(sqSize_, IORING_OFF_SQ_RING);
+        cq_ = singleMmap ? sq_ : map(cqSize_, IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqesSize_, IORING_OFF_SQES));
+
+        sqTail_ = offsetPointer<unsigned>(sq_, params.sq_off.tail);
+        sqMask_ = *offsetPointer<unsigned>(sq_, params.sq_off.ring_mask);
+        sqArray_ = offsetPointer<unsigned>(sq_, params.sq_off.array);
+        cqHead_ = offsetPointer<unsigned>(cq_, params.cq_off.head);
+        cqTail_ = offsetPointer<unsigned>(cq_, params.cq_off.tail);
+        cqMask_ = *offsetPointer<unsigned>(cq_, params.cq_off.ring_mask);
+        cqes_ = offsetPointer<io_uring_cqe>(cq_, params.cq_off.cqes);
+
+        // At most one submission per buffer is in flight, so neither queue can overflow
+        const auto buffers = std::min<std::size_t>(depth, params.sq_entries);
+        std::vector<iovec> iovecs(buffers);
+        for (std::size_t b = 0; b < buffers; ++b) {
+            iovecs[b] = iovec{buffer(b), bufferSize_};
+            freeBuffers_.push_back(b);
+        }
+        requests_.resize(buffers);
+
+        fixed_ = uringRegister(fd_, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(buffers)) == 0;
+        if (!fixed_) {
+            eckit::Log::warning() << "io_uring: registering buffers failed (" << std::strerror(errno)
+                                  << "), falling back to unregistered buffers" << std::endl;
+        }
+
+        reaper_ = std::thread{&Ring::reap, this};
+    }
+
+    ~Ring() {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            cv_.wait(lock, [this]() { return freeBuffers_.size() == requests_.size(); });
+            stop_ = true;
+
+            // Wake up the reaper
+            auto* sqe = nextSqe();
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = 0;
+            enter(1);
+        }
+        reaper_.join();
+
+        ::munmap(sqes_, sqesSize_);
+        if (cq_ != sq_) {
+            ::munmap(cq_, cqSize_);
+        }
+        ::munmap(sq_, sqSize_);
+        ::close(fd_);
+        std::free(memory_);
+    }
+
+    void* map(std::size_t size, off_t offset) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        if (p == MAP_FAILED) {
+            throw eckit::FailedSystemCall("mmap io_uring", Here());
+        }
+        return p;
+    }
+
+    char* buffer(std::size_t b) const { return static_cast<char*>(memory_) + b * bufferSize_; }
+
+    // The caller holds mutex_, fills in the entry and submits it with enter()
+    io_uring_sqe* nextSqe() {
+        const auto index = *sqTail_ & sqMask_;
+        auto* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        return sqe;
+    }
+
+    // The caller holds mutex_
+    void submit(Request& request) {
+        auto* sqe = nextSqe();
+        sqe->opcode = fixed_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd = request.file->fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(buffer(request.buffer) + request.done);
+        sqe->len = static_cast<std::uint32_t>(request.length - request.done);
+        sqe->off = static_cast<std::uint64_t>(request.offset) + request.done;
+        sqe->buf_index = static_cast<std::uint16_t>(request.buffer);
+        sqe->user_data = reinterpret_cast<std::uint64_t>(&request);
+        enter(1);
+    }
+
+    // Publishes the entry from nextSqe() and submits it
+    void enter(unsigned toSubmit) {
+        __atomic_store_n(sqTail_, *sqTail_ + toSubmit, __ATOMIC_RELEASE);
+        while (uringEnter(fd_, toSubmit, 0, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                throw eckit::FailedSystemCall("io_uring_enter", Here());
+            }
+        }
+    }
+
+    void reap() {
+        for (;;) {
+            if (uringEnter(fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                eckit::Log::error() << "io_uring: waiting for completions failed: " << std::strerror(errno)
+                                    << std::endl;
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock{mutex_};
+
+            auto head = *cqHead_;
+            const auto tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const auto& cqe = cqes_[head & cqMask_];
+                if (cqe.user_data != 0) {
+                    complete(*reinterpret_cast<Request*>(cqe.user_data), cqe.res);
+                }
+            }
+            __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+            if (stop_) {
+                return;
+            }
+        }
+    }
+
+    // The caller holds mutex_
+    void complete(Request& request, int res) {
+        if (res > 0) {
+            request.done += static_cast<std::size_t>(res);
+            if (request.done < request.length) {
+                LOG_DEBUG_LIB(LibMultio) << "io_uring: short write, resubmitting the rest" << std::endl;
+                try {
+                    submit(request);
+                    return;
+                }
+                catch (const eckit::FailedSystemCall&) {
+                    res = -errno;
+                }
+            }
+        }
+        if ((res <= 0) && (request.file->error == 0)) {
+            request.file->error = (res < 0) ? -res : EIO;
+        }
+        release(request);
+    }
+
+    // The caller holds mutex_
+    void release(Request& request) {
+        --request.file->pending;
+        freeBuffers_.push_back(request.buffer);
+        cv_.notify_all();
+    }
+
+    std::size_t bufferSize_;
+    void* memory_;
+
+    int fd_ = -1;
+    bool fixed_ = false;
+
+    void* sq_ = nullptr;
+    void* cq_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqSize_ = 0;
+    std::size_t cqSize_ = 0;
+    std::size_t sqesSize_ = 0;
+
+    unsigned* sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::size_t> freeBuffers_;
+    std::vector<Request> requests_;  // One per buffer
+    bool stop_ = false;
+
+    std::thread reaper_;
+};
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+UringFileHandle::UringFileHandle(const eckit::PathName& path) : path_{path} {}
+
+UringFileHandle::~UringFileHandle() {
+    try {
+        close();
+    }
+    catch (const std::exception& e) {
+        eckit::Log::error() << "Closing " << *this << " failed: " << e.what() << std::endl;
+    }
+}
+
+void UringFileHandle::openForWrite(const eckit::Length&) {
+    open(O_WRONLY | O_CREAT | O_TRUNC);
+}
+
+void UringFileHandle::openForAppend(const eckit::Length&) {
+    open(O_WRONLY | O_CREAT);
+
+    struct stat st;
+    if (::fstat(file_.fd, &st) < 0) {
+        throw eckit::FailedSystemCall("fstat " + path_.asString(), Here());
+    }
+    offset_ = st.st_size;
+}
+
+void UringFileHandle::open(int flags) {
+    ASSERT(file_.fd < 0);
+
+    file_.fd = ::open(path_.localPath(), flags, 0644);
+    if (file_.fd < 0) {
+        throw eckit::FailedSystemCall("open " + path_.asString(), Here());
+    }
+    offset_ = 0;
+}
+
+long UringFileHandle::write(const void* data, long length) {
+    auto& ring = Ring::instance();
+
+    const auto* p = static_cast<const char*>(data);
+    auto remaining = static_cast<std::size_t>(length);
+    while (remaining > 0) {
+        const auto n = std::min(remaining, ring.bufferSize());
+        ring.write(file_, p, n, offset_);
+        p += n;
+        remaining -= n;
+        offset_ += static_cast<off_t>(n);
+    }
+    return length;
+}
+
+void UringFileHandle::flush() {
+    if (file_.fd >= 0) {
+        Ring::instance().wait(file_);
+    }
+}
+
+void UringFileHandle::close() {
+    if (file_.fd < 0) {
+        return;
+    }
+
+    std::exception_ptr error;
+    try {
+        flush();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    const auto rc = ::close(file_.fd);
+    file_.fd = -1;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (rc < 0) {
+        throw eckit::FailedSystemCall("close " + path_.asString(), Here());
+    }
+}
+
+void UringFileHandle::print(std::ostream& os) const {
+    os << "UringFileHandle[path=" << path_ << "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
@@ -0,0 +1,75 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <iosfwd>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/DataHandle.h"
+
+namespace multio::sink {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Write-only file handle that writes asynchronously through a Linux io_uring.
+ *
+ * All handles of a process share one ring with a pool of registered buffers. A write copies the data into free
+ * buffers and queues it, so it only blocks when all buffers are in flight. A dedicated thread reaps the completions
+ * and returns the buffers to the pool. flush() and close() wait until all writes of the file are complete and rethrow
+ * their errors.
+ *
+ * The ring is sized by the resources multioUringQueueDepth (number of buffers, default 64) and multioUringBufferSize
+ * (bytes per buffer, default 1 MiB). If the buffers can not be registered, e.g. because of RLIMIT_MEMLOCK, plain
+ * writes are queued instead of fixed-buffer writes.
+ */
+class UringFileHandle final : public eckit::DataHandle {
+public:
+    struct File {
+        int fd = -1;
+        std::size_t pending = 0;  // Queued writes, guarded by the ring
+        int error = 0;            // First errno of a failed write, guarded by the ring
+    };
+
+    explicit UringFileHandle(const eckit::PathName& path);
+
+    ~UringFileHandle() override;
+
+    UringFileHandle(const UringFileHandle&) = delete;
+    UringFileHandle& operator=(const UringFileHandle&) = delete;
+
+    void openForWrite(const eckit::Length&) override;
+    void openForAppend(const eckit::Length&) override;
+
+    long write(const void* data, long length) override;
+
+    /// Waits until all queued writes are in the file
+    void flush() override;
+
+    void close() override;
+
+private:  // methods
+    void print(std::ostream&) const override;
+
+    void open(int flags);
+
+private:  // members
+    eckit::PathName path_;
+    File file_;
+    off_t offset_ = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::sink
@@ -1,11 +1,15 @@
 #include "multio/LibMultio.h"
 #include "multio/tools/MultioTool.h"
+#include "multio/util/ChromeTrace.h"
 
 #include "eckit/log/Log.h"
 #include "eckit/option/SimpleOption.h"
 
 #include <algorithm>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -23,6 +27,17 @@ void writeEvent(int csvFileHandle, uint64_t uniqueEventId, uint64_t traceEventId
 
     write(csvFileHandle, reinterpret_cast<const void*>(line.c_str()), line.size());
 }
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::istringstream iss{s};
+    for (std::string part; std::getline(iss, part, sep);) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
 }  // namespace
 
 struct Statistics {
@@ -52,6 +67,9 @@ MultioConvertTraceLog::MultioConvertTraceLog(int argc, char** argv) : multio::Mu
     options_.push_back(new eckit::option::SimpleOption<std::string>("input", "Trace file input path"));
     options_.push_back(new eckit::option::SimpleOption<std::string>("output", "Output CSV file path"));
     options_.push_back(new eckit::option::SimpleOption<bool>("stats", "Output only statistics in CSV file"));
+    options_.push_back(new eckit::option::SimpleOption<bool>(
+        "chrome-trace", "Output a Chrome trace JSON file for chrome://tracing or Perfetto, input may list several "
+                        "trace files separated by commas"));
 }
 
 void MultioConvertTraceLog::init(const eckit::option::CmdArgs& args) {}
@@ -68,6 +86,15 @@ void MultioConvertTraceLog::execute(const eckit::option::CmdArgs& args) {
     bool stats = false;
     args.get("stats", stats);
 
+    bool chromeTrace = false;
+    args.get("chrome-trace", chromeTrace);
+
+    if (chromeTrace) {
+        std::ofstream out{output};
+        multio::util::writeChromeTrace(split(input, ','), out);
+        return;
+    }
+
     const auto csvFileHandle = open(output.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IWUSR | S_IRUSR);
 
     if (!stats) {
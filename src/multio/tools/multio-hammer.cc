@@ -181,7 +181,7 @@ std::vector<double>& global_test_field(const std::string& field_id, const size_t
         return test_fields[field_id];
     }
 
-    if (transport == "mpi" && new_random_data_each_run()) {
+    if ((transport == "mpi" || transport == "shm") && new_random_data_each_run()) {
         test_fields[field_id] = (root() == list_id) ? create_random_data(sz) : std::vector<double>(sz);
         comm().broadcast(test_fields[field_id], root());
 
@@ -205,6 +205,7 @@ const std::string& test_configuration_key(const std::string& transportType) {
     eckit::Log::debug<multio::LibMultio>() << "Transport type: " << transportType << std::endl;
 
     static std::map<std::string, std::string> configs = {{"mpi", "mpi-test-configuration"},
+                                                         {"shm", "shm-test-configuration"},
                                                          {"tcp", "tcp-test-configuration"},
                                                          {"thread", "thread-test-configuration"},
                                                          {"none", "no-transport-test-configuration"}};
@@ -275,7 +276,8 @@ private:
                 multioHandle->multioConfig().setLocalPeerTag(multio::config::LocalPeerTag::Server);
             }
             return std::shared_ptr<Transport>(
-                TransportFactory::instance().build("mpi", ComponentConfiguration(conf_, multioHandle->multioConfig())));
+                TransportFactory::instance().build(conf_.getString("transport"),
+                                                   ComponentConfiguration(conf_, multioHandle->multioConfig())));
         };
 
         void checkData(MultioHammer& hammer) const override {
@@ -439,6 +441,7 @@ private:
     long ensMember_ = 1;
     long sleep_ = 0;
     bool checkDataOnly_ = false;
+    bool buffered_ = false;
 
     std::unique_ptr<TestPolicy> testPolicy_;
 
@@ -448,14 +451,19 @@ private:
         std::shared_ptr<Transport> transport_;
         Peer source_;
         Peer destination_;
+        bool sendClose_;
 
     public:
-        Connection(std::shared_ptr<Transport> tprt, Peer src, Peer dest) :
-            transport_{tprt}, source_{src}, destination_{dest} {
+        Connection(std::shared_ptr<Transport> tprt, Peer src, Peer dest, bool sendClose = true) :
+            transport_{tprt}, source_{src}, destination_{dest}, sendClose_{sendClose} {
             transport_->send(Message{Message::Header{Message::Tag::Open, source_, destination_}});
         }
 
-        ~Connection() { transport_->send(Message{Message::Header{Message::Tag::Close, source_, destination_}}); }
+        ~Connection() {
+            if (sendClose_) {
+                transport_->send(Message{Message::Header{Message::Tag::Close, source_, destination_}});
+            }
+        }
 
         Connection(const Connection& rhs) = delete;
         Connection(Connection&& rhs) noexcept = delete;
@@ -479,6 +487,8 @@ MultioHammer::MultioHammer(int argc, char** argv) : multio::MultioTool(argc, arg
     options_.push_back(new eckit::option::SimpleOption<size_t>("member", "Ensemble member"));
     options_.push_back(new eckit::option::SimpleOption<long>("sleep", "Seconds of simulated work per step"));
     options_.push_back(new eckit::option::SimpleOption<bool>("check-data-only", "For TCP: will only check data"));
+    options_.push_back(
+        new eckit::option::SimpleOption<bool>("buffered", "Send fields with bufferedSend and close connections at once"));
 }
 
 
@@ -495,6 +505,7 @@ void MultioHammer::init(const eckit::option::CmdArgs& args) {
     args.get("member", ensMember_);
     args.get("sleep", sleep_);
     args.get("check-data-only", checkDataOnly_);
+    args.get("buffered", buffered_);
 
     MultioConfiguration multioConf;
     if (configPath_.empty()) {
@@ -507,11 +518,14 @@ void MultioHammer::init(const eckit::option::CmdArgs& args) {
     }
 
     conf_.set("clientCount", clientCount_);
+    conf_.set("serverCount", serverCount_);
 
     using PolicyBuilder = std::function<std::unique_ptr<TestPolicy>()>;
     std::map<std::string, PolicyBuilder> const policyFactory = {
         {"mpi",
          [this, &multioConf]() { return std::make_unique<MPITestPolicy>(conf_, std::move(multioConf), clientCount_); }},
+        {"shm",
+         [this, &multioConf]() { return std::make_unique<MPITestPolicy>(conf_, std::move(multioConf), clientCount_); }},
         {"tcp",
          [this, &multioConf]() {
              return std::make_unique<TCPTestPolicy>(conf_, std::move(multioConf), clientCount_, port_, checkDataOnly_);
@@ -545,10 +559,10 @@ void MultioHammer::sendData(const PeerList& serverPeers, std::shared_ptr<Transpo
     // TODO Use multio client poperly instead of accessing transport
     const Peer& client = transport->localPeer();
 
-    // Open all servers and close them when going out of scope
+    // Open all servers and close them when going out of scope, buffered messages are flushed by closeConnections
     std::vector<std::unique_ptr<Connection>> connections;
     for (auto& server : serverPeers) {
-        connections.emplace_back(std::make_unique<Connection>(transport, client, *server));
+        connections.emplace_back(std::make_unique<Connection>(transport, client, *server, !buffered_));
     }
 
     auto idxm = generate_index_map(client_list_id, clientCount_);
@@ -603,7 +617,12 @@ void MultioHammer::sendData(const PeerList& serverPeers, std::shared_ptr<Transpo
                 Message msg{Message::Header{Message::Tag::Field, client, *serverPeers[id], std::move(metadata)},
                             std::move(buffer)};
 
-                transport->send(msg);
+                if (buffered_) {
+                    transport->bufferedSend(msg);
+                }
+                else {
+                    transport->send(msg);
+                }
             }
         }
 
@@ -615,9 +634,18 @@ void MultioHammer::sendData(const PeerList& serverPeers, std::shared_ptr<Transpo
         md.set("domain", "grid-point");
         for (auto& server : serverPeers) {
             Message flush{Message::Header{Message::Tag::Flush, client, *server, Metadata{md}}};
-            transport->send(flush);
+            if (buffered_) {
+                transport->bufferedSend(flush);
+            }
+            else {
+                transport->send(flush);
+            }
         }
     }
+
+    if (buffered_) {
+        transport->closeConnections();
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------
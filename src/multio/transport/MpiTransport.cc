@@ -21,26 +21,13 @@
 
 #include "multio/transport/MpiCommSetup.h"
 #include "multio/util/Environment.h"
+#include "multio/util/TraceSpan.h"
 
 namespace multio::transport {
 
 namespace {
 Message decodeMessage(eckit::Stream& stream) {
-    unsigned t;
-    stream >> t;
-
-    std::string src_grp;
-    stream >> src_grp;
-    size_t src_id;
-    stream >> src_id;
-
-    std::string dest_grp;
-    stream >> dest_grp;
-    size_t dest_id;
-    stream >> dest_id;
-
-    std::string fieldId;
-    stream >> fieldId;
+    auto header = Message::Header::decode(stream);
 
     unsigned long sz;
     stream >> sz;
@@ -48,13 +35,16 @@ Message decodeMessage(eckit::Stream& stream) {
     eckit::Buffer buffer(sz);
     stream >> buffer;
 
-    return Message{Message::Header{static_cast<Message::Tag>(t), MpiPeer{src_grp, src_id}, MpiPeer{dest_grp, dest_id},
-                                   std::move(fieldId)},
-                   std::move(buffer)};
+    return Message{std::move(header), std::move(buffer)};
 }
 
+// Large payloads are sent as a header message followed by the raw payload, outside the range of message tags
+const int directHeaderTag = static_cast<int>(Message::Tag::ENDTAG) + 1;
+const int directPayloadTag = static_cast<int>(Message::Tag::ENDTAG) + 2;
+
 const size_t defaultBufferSize = 64 * 1024 * 1024;
 const size_t defaultPoolSize = 128;
+const size_t defaultDirectPayloadSize = 8 * 1024 * 1024;
 
 MpiPeerSetup setupMPI_(const ComponentConfiguration& compConf) {
     const std::string& groupName = compConf.parsedConfig().getString("group", "multio");
@@ -211,6 +201,17 @@ size_t getMpiBufferSize(const ComponentConfiguration& compConf) {
     }
 }
 
+size_t getMpiDirectPayloadSize(const ComponentConfiguration& compConf) {
+    // Payloads that would not fit into a pool buffer have to be sent directly in any case
+    const size_t maxSize = getMpiBufferSize(compConf) / 2;
+
+    auto pMul = util::getEnv("MULTIO_MPI_DIRECT_PAYLOAD_SIZE");
+    if (pMul) {
+        return std::min(eckit::translate<size_t>(std::string{*pMul}), maxSize);
+    };
+    return std::min(defaultDirectPayloadSize, maxSize);
+}
+
 
 }  // namespace
 
@@ -222,6 +223,7 @@ MpiTransport::MpiTransport(const ComponentConfiguration& compConf, MpiPeerSetup&
     clientGroup_{std::move(std::get<2>(peerSetup))},
     serverGroup_{std::move(std::get<3>(peerSetup))},
     pool_{getMpiPoolSize(compConf), getMpiBufferSize(compConf), comm(), statistics_},
+    directPayloadSize_{getMpiDirectPayloadSize(compConf)},
     streamQueue_{1024} {}
 
 MpiTransport::MpiTransport(const ComponentConfiguration& compConf) : MpiTransport(compConf, setupMPI_(compConf)) {}
@@ -265,19 +267,46 @@ Message MpiTransport::receive() {
 
         ReceivedBuffer streamArgs;
         streamQueue_.pop(streamArgs);
-        if (streamArgs.buffer) {
-            eckit::ResizableMemoryStream strm{streamArgs.buffer->content};
-            while (strm.position() < streamArgs.size) {
-                util::ScopedTiming decodeTiming{statistics_.decodeTiming_};
-                auto msg = decodeMessage(strm);
-                msgPack_.push(std::move(msg));
-            }
-            streamArgs.buffer->status.store(BufferStatus::available, std::memory_order_release);
-        }
+        queuedBuffers_.fetch_sub(1, std::memory_order_relaxed);
+        unpack(streamArgs);
 
     } while (true);
 }
 
+std::optional<Message> MpiTransport::tryReceive() {
+    // Only buffers counted as queued are popped. They are counted right before they are pushed, so this does not wait
+    // for the next message
+    while (msgPack_.empty() && (queuedBuffers_.load(std::memory_order_acquire) > 0)) {
+        ReceivedBuffer streamArgs;
+        streamQueue_.pop(streamArgs);
+        queuedBuffers_.fetch_sub(1, std::memory_order_relaxed);
+        unpack(streamArgs);
+    }
+
+    if (msgPack_.empty()) {
+        return std::nullopt;
+    }
+    auto msg = std::move(msgPack_.front());
+    msgPack_.pop();
+    return msg;
+}
+
+void MpiTransport::unpack(ReceivedBuffer& streamArgs) {
+    if (streamArgs.buffer) {
+        eckit::ResizableMemoryStream strm{streamArgs.buffer->content};
+        while (strm.position() < streamArgs.size) {
+            util::ScopedTiming decodeTiming{statistics_.decodeTiming_};
+            MULTIO_TRACE_SPAN(util::MULTIO_SPAN_DECODE);
+            auto msg = decodeMessage(strm);
+            msgPack_.push(std::move(msg));
+        }
+        streamArgs.buffer->status.store(BufferStatus::available, std::memory_order_release);
+    }
+    else if (streamArgs.message) {
+        msgPack_.push(std::move(*streamArgs.message));
+    }
+}
+
 void MpiTransport::abort(std::exception_ptr ptr) {
     streamQueue_.interrupt(ptr);
     comm().abort();
@@ -286,6 +315,11 @@ void MpiTransport::abort(std::exception_ptr ptr) {
 void MpiTransport::send(const Message& msg) {
     std::lock_guard<std::mutex> lock{mutex_};
 
+    if (msg.size() >= directPayloadSize_) {
+        sendDirect(msg);
+        return;
+    }
+
     auto msg_tag = static_cast<int>(msg.tag());
 
     // TODO: find available buffer instead
@@ -311,6 +345,13 @@ void MpiTransport::send(const Message& msg) {
 
 void MpiTransport::bufferedSend(const Message& msg) {
     std::lock_guard<std::mutex> lock{mutex_};
+
+    if (msg.size() >= directPayloadSize_) {
+        // Keep the order of messages to this destination
+        pool_.flushStream(msg.destination(), static_cast<int>(msg.tag()));
+        sendDirect(msg);
+        return;
+    }
     encodeMessage(pool_.getStream(msg), msg);
 }
 
@@ -350,11 +391,16 @@ void MpiTransport::listen() {
     if (status.error()) {
         return;
     }
+    if (status.tag() == directHeaderTag) {
+        receiveDirect(status);
+        return;
+    }
     // TODO status contains information on required message size - use that to retrieve a sufficient
     // large buffer?
     auto& buf = pool_.acquireAvailableBuffer(BufferStatus::fillingUp);
     auto sz = blockingReceive(status, buf);
     util::ScopedTiming timing{statistics_.pushToQueueTiming_};
+    queuedBuffers_.fetch_add(1, std::memory_order_release);
     streamQueue_.push(ReceivedBuffer{&buf, sz});
 }
 
@@ -378,6 +424,21 @@ PeerList MpiTransport::createServerPeers() const {
     return serverPeers;
 }
 
+std::set<Peer> MpiTransport::nodeLocalPeers() const {
+    const auto hostHash = std::hash<std::string>{}(eckit::Main::hostname());
+
+    std::vector<size_t> hostHashes(comm().size());
+    comm().allGather(hostHash, hostHashes.begin(), hostHashes.end());
+
+    std::set<Peer> localPeers;
+    for (size_t rank = 0; rank < hostHashes.size(); ++rank) {
+        if (hostHashes[rank] == hostHash) {
+            localPeers.emplace(local_.group(), rank);
+        }
+    }
+    return localPeers;
+}
+
 const eckit::mpi::Comm& MpiTransport::comm() const {
     return eckit::mpi::comm(local_.group().c_str());
 }
@@ -408,6 +469,49 @@ void MpiTransport::encodeMessage(eckit::Stream& strm, const Message& msg) {
     msg.encode(strm);
 }
 
+void MpiTransport::sendDirect(const Message& msg) {
+    eckit::Buffer buffer{4096};
+    eckit::ResizableMemoryStream stream{buffer};
+    {
+        util::ScopedTiming timing{statistics_.encodeTiming_};
+        msg.header().encode(stream);
+        stream << static_cast<unsigned long>(msg.size());
+    }
+
+    util::ScopedTiming timing{statistics_.sendTiming_};
+
+    // The payload goes out straight from the message, without being copied into a pool buffer
+    auto dest = static_cast<int>(msg.destination().id());
+    comm().send<void>(buffer, static_cast<size_t>(stream.bytesWritten()), dest, directHeaderTag);
+    comm().send<void>(msg.payload().data(), msg.size(), dest, directPayloadTag);
+
+    ++statistics_.sendCount_;
+    statistics_.sendSize_ += static_cast<size_t>(stream.bytesWritten()) + msg.size();
+}
+
+void MpiTransport::receiveDirect(eckit::mpi::Status& status) {
+    auto sz = comm().getCount<void>(status);
+    eckit::Buffer buffer{sz};
+
+    util::ScopedTiming timing{statistics_.receiveTiming_};
+    comm().receive<void>(buffer, sz, status.source(), directHeaderTag);
+
+    eckit::MemoryStream stream{buffer};
+    auto header = Message::Header::decode(stream);
+    unsigned long payloadSize;
+    stream >> payloadSize;
+
+    // The sender posts the payload right after the header, receive it into the buffer of the message itself
+    eckit::Buffer payload{payloadSize};
+    comm().receive<void>(payload, payloadSize, status.source(), directPayloadTag);
+
+    ++statistics_.receiveCount_;
+    statistics_.receiveSize_ += sz + payloadSize;
+
+    queuedBuffers_.fetch_add(1, std::memory_order_release);
+    streamQueue_.push(ReceivedBuffer{nullptr, 0, Message{std::move(header), std::move(payload)}});
+}
+
 static TransportBuilder<MpiTransport> MpiTransportBuilder("mpi");
 
 }  // namespace multio::transport
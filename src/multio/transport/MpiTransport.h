@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <optional>
 #include <queue>
 #include <tuple>
 
@@ -35,6 +37,8 @@ namespace multio::transport {
 struct ReceivedBuffer {
     MpiBuffer* buffer;
     size_t size;
+    // Set instead of buffer for a message whose payload has been received directly
+    std::optional<Message> message = std::nullopt;
 };
 
 using MpiPeerSetup = std::tuple<MpiPeer, eckit::mpi::Group, eckit::mpi::Group, eckit::mpi::Group>;
@@ -51,6 +55,7 @@ private:
     void closeConnections() override;
 
     Message receive() override;
+    std::optional<Message> tryReceive() override;
 
     void abort(std::exception_ptr) override;
 
@@ -68,6 +73,8 @@ private:
 
     PeerList createServerPeers() const override;
 
+    std::set<Peer> nodeLocalPeers() const override;
+
     const eckit::mpi::Comm& comm() const;
 
     eckit::mpi::Status probe();
@@ -75,6 +82,12 @@ private:
 
     void encodeMessage(eckit::Stream& strm, const Message& msg);
 
+    void sendDirect(const Message& msg);
+    void receiveDirect(eckit::mpi::Status& status);
+
+    // Decodes the messages of a received buffer into msgPack_
+    void unpack(ReceivedBuffer& streamArgs);
+
     MpiPeer local_;
     eckit::mpi::Group parentGroup_;
     eckit::mpi::Group clientGroup_;
@@ -82,7 +95,12 @@ private:
 
     StreamPool pool_;
 
+    // Payloads from this size on bypass the stream pool
+    const size_t directPayloadSize_;
+
     eckit::Queue<ReceivedBuffer> streamQueue_;
+    // Buffers pushed to streamQueue_ and not popped yet
+    std::atomic<size_t> queuedBuffers_{0};
 
     std::queue<Message> msgPack_;
 };
@@ -0,0 +1,292 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "ShmRing.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/maths/Functions.h"
+
+namespace multio::transport {
+
+namespace {
+
+constexpr std::uint64_t ringMagic = 0x6d756c74696f5348;  // "multioSH"
+
+constexpr std::size_t cacheLine = 64;
+
+constexpr unsigned spinRounds = 64;
+constexpr unsigned yieldRounds = 128;
+const auto sleepPeriod = std::chrono::microseconds(50);
+
+struct Frame {
+    std::uint64_t headerSize;
+    std::uint64_t payloadSize;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Shared-memory ring requires lock-free 64 bit atomics to work across processes");
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void ShmBackoff::wait() {
+    if (rounds_ < spinRounds) {
+        ++rounds_;
+    }
+    else if (rounds_ < yieldRounds) {
+        ++rounds_;
+        std::this_thread::yield();
+    }
+    else {
+        std::this_thread::sleep_for(sleepPeriod);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Header of the segment, followed by the slots
+struct ShmRingLayout {
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t slotSize;
+    std::uint64_t slotCount;
+
+    // Consumer and producer position on separate cache lines
+    alignas(cacheLine) std::atomic<std::uint64_t> head;
+    alignas(cacheLine) std::atomic<std::uint64_t> tail;
+};
+
+namespace {
+
+std::size_t slotsOffset() {
+    return static_cast<std::size_t>(eckit::round(sizeof(ShmRingLayout), cacheLine));
+}
+
+std::size_t segmentSize(std::size_t slotSize, std::size_t slotCount) {
+    return slotsOffset() + slotSize * slotCount;
+}
+
+}  // namespace
+
+std::unique_ptr<ShmRing> ShmRing::create(const std::string& name, std::size_t slotSize, std::size_t slotCount) {
+    ASSERT(slotSize >= sizeof(Frame));
+    ASSERT(slotSize % cacheLine == 0);
+    ASSERT(slotCount > 0);
+
+    // Remove a segment left behind by a previous run that did not terminate cleanly
+    ::shm_unlink(name.c_str());
+
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        throw eckit::FailedSystemCall("shm_open " + name, Here());
+    }
+
+    const auto size = segmentSize(slotSize, slotCount);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw eckit::FailedSystemCall("ftruncate " + name, Here());
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        ::shm_unlink(name.c_str());
+        throw eckit::FailedSystemCall("mmap " + name, Here());
+    }
+
+    auto* layout = new (addr) ShmRingLayout{};
+    layout->slotSize = slotSize;
+    layout->slotCount = slotCount;
+    layout->head.store(0, std::memory_order_relaxed);
+    layout->tail.store(0, std::memory_order_relaxed);
+
+    // Publish last: the consumer does not touch a segment before it sees the magic number
+    layout->magic.store(ringMagic, std::memory_order_release);
+
+    return std::unique_ptr<ShmRing>{new ShmRing{name, addr, size, true}};
+}
+
+std::unique_ptr<ShmRing> ShmRing::tryAttach(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return nullptr;
+        }
+        throw eckit::FailedSystemCall("shm_open " + name, Here());
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw eckit::FailedSystemCall("fstat " + name, Here());
+    }
+
+    // Not resized yet
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < slotsOffset()) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw eckit::FailedSystemCall("mmap " + name, Here());
+    }
+
+    auto* layout = static_cast<ShmRingLayout*>(addr);
+    if (layout->magic.load(std::memory_order_acquire) != ringMagic) {
+        ::munmap(addr, size);
+        return nullptr;
+    }
+    ASSERT(size == segmentSize(layout->slotSize, layout->slotCount));
+
+    // Both ends hold a mapping from now on, the name is no longer needed
+    ::shm_unlink(name.c_str());
+
+    return std::unique_ptr<ShmRing>{new ShmRing{name, addr, size, false}};
+}
+
+ShmRing::ShmRing(const std::string& name, void* addr, std::size_t mappedSize, bool owner) :
+    name_{name},
+    addr_{addr},
+    mappedSize_{mappedSize},
+    owner_{owner},
+    layout_{static_cast<ShmRingLayout*>(addr)},
+    slots_{static_cast<char*>(addr) + slotsOffset()} {}
+
+ShmRing::~ShmRing() {
+    ::munmap(addr_, mappedSize_);
+    if (owner_) {
+        // Only still present if the consumer never attached
+        ::shm_unlink(name_.c_str());
+    }
+}
+
+char* ShmRing::slot(std::size_t index) const {
+    return slots_ + (index % layout_->slotCount) * layout_->slotSize;
+}
+
+void ShmRing::write(const void* header, std::size_t headerSize, const void* payload, std::size_t payloadSize) {
+    ASSERT(offset_ == 0);
+
+    Frame frame{headerSize, payloadSize};
+    put(&frame, sizeof(frame));
+    put(header, headerSize);
+    put(payload, payloadSize);
+
+    // Publish the partially filled last slot, the next message starts on a fresh one
+    if (offset_ > 0) {
+        layout_->tail.store(++index_, std::memory_order_release);
+        offset_ = 0;
+    }
+}
+
+void ShmRing::put(const void* src, std::size_t size) {
+    const auto* bytes = static_cast<const char*>(src);
+    const std::size_t slotSize = layout_->slotSize;
+    const std::size_t slotCount = layout_->slotCount;
+
+    while (size > 0) {
+        if (offset_ == 0) {
+            ShmBackoff backoff;
+            while (index_ - layout_->head.load(std::memory_order_acquire) == slotCount) {
+                backoff.wait();
+            }
+        }
+
+        const auto n = std::min(size, slotSize - offset_);
+        std::memcpy(slot(index_) + offset_, bytes, n);
+        bytes += n;
+        size -= n;
+        offset_ += n;
+
+        if (offset_ == slotSize) {
+            layout_->tail.store(++index_, std::memory_order_release);
+            offset_ = 0;
+        }
+    }
+}
+
+void ShmRing::drain() {
+    ShmBackoff backoff;
+    while (layout_->head.load(std::memory_order_acquire) != index_) {
+        backoff.wait();
+    }
+}
+
+bool ShmRing::pending() const {
+    return layout_->tail.load(std::memory_order_acquire) != index_;
+}
+
+eckit::Buffer ShmRing::read(std::vector<char>& header) {
+    ASSERT(offset_ == 0);
+
+    Frame frame;
+    get(&frame, sizeof(frame));
+
+    header.resize(frame.headerSize);
+    get(header.data(), frame.headerSize);
+
+    eckit::Buffer payload{frame.payloadSize};
+    get(payload.data(), frame.payloadSize);
+
+    // Release the partially used last slot
+    if (offset_ > 0) {
+        layout_->head.store(++index_, std::memory_order_release);
+        offset_ = 0;
+    }
+
+    return payload;
+}
+
+void ShmRing::get(void* dst, std::size_t size) {
+    auto* bytes = static_cast<char*>(dst);
+    const std::size_t slotSize = layout_->slotSize;
+
+    while (size > 0) {
+        if (offset_ == 0) {
+            ShmBackoff backoff;
+            while (layout_->tail.load(std::memory_order_acquire) == index_) {
+                backoff.wait();
+            }
+        }
+
+        const auto n = std::min(size, slotSize - offset_);
+        std::memcpy(bytes, slot(index_) + offset_, n);
+        bytes += n;
+        size -= n;
+        offset_ += n;
+
+        if (offset_ == slotSize) {
+            layout_->head.store(++index_, std::memory_order_release);
+            offset_ = 0;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::transport
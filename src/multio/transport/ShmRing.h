@@ -0,0 +1,92 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/io/Buffer.h"
+#include "eckit/memory/NonCopyable.h"
+
+namespace multio::transport {
+
+struct ShmRingLayout;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Polling strategy for shared-memory indices: spins first, then yields, then sleeps between polls
+class ShmBackoff {
+public:
+    void wait();
+    void reset() { rounds_ = 0; }
+
+private:
+    unsigned rounds_ = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Bounded ring of fixed-size slots in a named POSIX shared-memory segment, for exactly one producer and one consumer
+/// process. Head and tail are lock-free slot counters in the segment header.
+///
+/// A message starts at a slot boundary and may span any number of slots, so the ring bounds the data in flight but not
+/// the message size: the producer fills slots while the consumer drains them. The producer creates the segment, the
+/// consumer attaches to it and immediately removes its name, so nothing is left in /dev/shm once both sides unmapped.
+class ShmRing : private eckit::NonCopyable {
+public:
+    static std::unique_ptr<ShmRing> create(const std::string& name, std::size_t slotSize, std::size_t slotCount);
+
+    /// @return nullptr if the producer has not created and initialised the segment yet
+    static std::unique_ptr<ShmRing> tryAttach(const std::string& name);
+
+    ~ShmRing();
+
+    /// Producer only. Blocks while the ring is full.
+    void write(const void* header, std::size_t headerSize, const void* payload, std::size_t payloadSize);
+
+    /// Producer only. Blocks until the consumer has read everything written so far.
+    void drain();
+
+    /// Consumer only. True if at least the first slot of a message has been published.
+    bool pending() const;
+
+    /// Consumer only. Blocks until the whole message has been read. The header bytes are returned in `header`, the
+    /// payload is copied once from the slots into the returned buffer.
+    eckit::Buffer read(std::vector<char>& header);
+
+    const std::string& name() const { return name_; }
+
+private:
+    ShmRing(const std::string& name, void* addr, std::size_t mappedSize, bool owner);
+
+    char* slot(std::size_t index) const;
+
+    void put(const void* src, std::size_t size);
+    void get(void* dst, std::size_t size);
+
+    std::string name_;
+    void* addr_;
+    std::size_t mappedSize_;
+    bool owner_;
+
+    ShmRingLayout* layout_;
+    char* slots_;
+
+    // Process-local cursor of this end of the ring: next slot and the offset within it
+    std::size_t index_ = 0;
+    std::size_t offset_ = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::transport
@@ -0,0 +1,272 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "ShmTransport.h"
+
+#include <unistd.h>
+
+#include <iostream>
+#include <sstream>
+
+#include "eckit/log/Log.h"
+#include "eckit/maths/Functions.h"
+#include "eckit/serialisation/MemoryStream.h"
+#include "eckit/serialisation/ResizableMemoryStream.h"
+
+#include "multio/LibMultio.h"
+#include "multio/util/TraceSpan.h"
+
+namespace multio::transport {
+
+namespace {
+
+const size_t defaultSlotSize = 64 * 1024;
+const size_t defaultSlotCount = 64;
+const size_t slotAlignment = 64;
+
+bool isServer(const ComponentConfiguration& compConf) {
+    return compConf.multioConfig().localPeerTag() == config::LocalPeerTag::Server;
+}
+
+}  // namespace
+
+ShmTransport::ShmTransport(const ComponentConfiguration& compConf) :
+    Transport(compConf),
+    interNode_{TransportFactory::instance().build(compConf.parsedConfig().getString("inter-node", "mpi"), compConf)},
+    segmentPrefix_{compConf.parsedConfig().getString("segment-prefix", "multio")},
+    slotSize_{static_cast<size_t>(
+        eckit::round(compConf.parsedConfig().getUnsigned("slot-size", defaultSlotSize), slotAlignment))},
+    slotCount_{compConf.parsedConfig().getUnsigned("slot-count", defaultSlotCount)},
+    localPeers_{interNode_->nodeLocalPeers()},
+    headerBuffer_{4096} {
+    const auto& local = localPeer();
+
+    if (isServer(compConf)) {
+        for (const auto& client : clientPeers()) {
+            if (localPeers_.find(*client) != localPeers_.end()) {
+                unattached_.push_back(*client);
+            }
+        }
+    }
+    else {
+        for (const auto& server : serverPeers()) {
+            if (localPeers_.find(*server) != localPeers_.end()) {
+                outgoing_.emplace(*server, ShmRing::create(ringName(local, *server), slotSize_, slotCount_));
+            }
+        }
+    }
+
+    LOG_DEBUG_LIB(LibMultio) << "ShmTransport: " << localPeers_.size() << " peers on this node, "
+                             << outgoing_.size() + unattached_.size() << " shared-memory rings" << std::endl;
+}
+
+ShmTransport::~ShmTransport() = default;
+
+void ShmTransport::openConnections() {
+    for (const auto& ring : outgoing_) {
+        writeToRing(*ring.second, Message{Message::Header{Message::Tag::Open, localPeer(), ring.first}});
+    }
+    // Opens all inter-node connections, the servers on this node discard the duplicates
+    interNode_->openConnections();
+}
+
+void ShmTransport::closeConnections() {
+    for (const auto& ring : outgoing_) {
+        writeToRing(*ring.second, Message{Message::Header{Message::Tag::Close, localPeer(), ring.first}});
+    }
+    for (const auto& ring : outgoing_) {
+        ring.second->drain();
+    }
+    interNode_->closeConnections();
+}
+
+Message ShmTransport::receive() {
+    // The inter-node transport is received on this thread only, as it would be without shared memory, so that it
+    // needs no more thread support (e.g. MPI_THREAD_MULTIPLE) than on its own
+    ShmBackoff backoff;
+    do {
+        auto msg = receiveInterNode();
+        if (!msg) {
+            msg = pollRings();
+        }
+
+        if (msg && (msg->tag() == Message::Tag::Close) && (closedCount_ + 1 == clientCount())) {
+            // The listener stops after the last close, the inter-node transport has to be done by then
+            lastClose_ = std::move(msg);
+            msg.reset();
+        }
+        if (lastClose_ && (interNodeClosedCount_ == clientCount())) {
+            msg = std::move(lastClose_);
+            lastClose_.reset();
+        }
+
+        if (msg) {
+            if (msg->tag() == Message::Tag::Close) {
+                ++closedCount_;
+            }
+            return std::move(*msg);
+        }
+
+        if (!unattached_.empty()) {
+            attachRings();
+        }
+        backoff.wait();
+    } while (true);
+}
+
+void ShmTransport::abort(std::exception_ptr ptr) {
+    interNode_->abort(ptr);
+}
+
+void ShmTransport::send(const Message& msg) {
+    auto it = outgoing_.find(msg.destination());
+    if (it == outgoing_.end()) {
+        interNode_->send(msg);
+        return;
+    }
+    writeToRing(*it->second, msg);
+
+    // The server only stops receiving from the inter-node transport once every client has closed it
+    if ((msg.tag() == Message::Tag::Open) || (msg.tag() == Message::Tag::Close)) {
+        interNode_->send(msg);
+    }
+}
+
+void ShmTransport::bufferedSend(const Message& msg) {
+    auto it = outgoing_.find(msg.destination());
+    if (it == outgoing_.end()) {
+        interNode_->bufferedSend(msg);
+        return;
+    }
+    // The ring already decouples client and server as long as it has free slots
+    writeToRing(*it->second, msg);
+}
+
+const Peer& ShmTransport::localPeer() const {
+    return interNode_->localPeer();
+}
+
+void ShmTransport::listen() {
+    interNode_->listen();
+}
+
+PeerList ShmTransport::createServerPeers() const {
+    return interNode_->createServerPeers();
+}
+
+std::set<Peer> ShmTransport::nodeLocalPeers() const {
+    return localPeers_;
+}
+
+void ShmTransport::createPeers() const {
+    for (const auto& peer : interNode_->clientPeers()) {
+        clientPeers_.emplace_back(std::make_unique<Peer>(*peer));
+    }
+    for (const auto& peer : interNode_->serverPeers()) {
+        serverPeers_.emplace_back(std::make_unique<Peer>(*peer));
+    }
+}
+
+void ShmTransport::print(std::ostream& os) const {
+    os << "ShmTransport(" << *interNode_ << ")";
+}
+
+std::string ShmTransport::ringName(const Peer& client, const Peer& server) const {
+    std::ostringstream oss;
+    oss << "/" << segmentPrefix_ << "-" << ::getuid() << "-" << client.group() << "-" << client.id() << "-"
+        << server.group() << "-" << server.id();
+    return oss.str();
+}
+
+void ShmTransport::writeToRing(ShmRing& ring, const Message& msg) {
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    eckit::ResizableMemoryStream stream{headerBuffer_};
+    {
+        util::ScopedTiming timing{statistics_.encodeTiming_};
+        msg.header().encode(stream);
+    }
+
+    util::ScopedTiming timing{statistics_.sendTiming_};
+    ring.write(headerBuffer_.data(), stream.bytesWritten(), msg.payload().data(), msg.size());
+
+    ++statistics_.sendCount_;
+    statistics_.sendSize_ += msg.size();
+}
+
+Message ShmTransport::readFromRing(ShmRing& ring) {
+    eckit::Buffer payload = [&]() {
+        util::ScopedTiming timing{statistics_.receiveTiming_};
+        return ring.read(headerBytes_);
+    }();
+
+    ++statistics_.receiveCount_;
+    statistics_.receiveSize_ += payload.size();
+
+    util::ScopedTiming timing{statistics_.decodeTiming_};
+    MULTIO_TRACE_SPAN(util::MULTIO_SPAN_DECODE);
+    eckit::MemoryStream stream{headerBytes_.data(), headerBytes_.size()};
+
+    return Message{Message::Header::decode(stream), std::move(payload)};
+}
+
+std::optional<Message> ShmTransport::pollRings() {
+    // Round robin, so that a busy client cannot starve the others
+    for (size_t i = 0; i < incoming_.size(); ++i) {
+        auto idx = (nextRing_ + i) % incoming_.size();
+        if (!incoming_[idx]->pending()) {
+            continue;
+        }
+
+        auto msg = readFromRing(*incoming_[idx]);
+        if (msg.tag() == Message::Tag::Close) {
+            incoming_.erase(incoming_.begin() + idx);
+            nextRing_ = incoming_.empty() ? 0 : idx % incoming_.size();
+        }
+        else {
+            nextRing_ = (idx + 1) % incoming_.size();
+        }
+        return msg;
+    }
+    return std::nullopt;
+}
+
+void ShmTransport::attachRings() {
+    const auto& local = localPeer();
+    for (auto it = unattached_.begin(); it != unattached_.end();) {
+        if (auto ring = ShmRing::tryAttach(ringName(*it, local))) {
+            incoming_.push_back(std::move(ring));
+            it = unattached_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+std::optional<Message> ShmTransport::receiveInterNode() {
+    // Every client closes its inter-node connections, including the clients on this node
+    while (auto msg = interNode_->tryReceive()) {
+        const bool connection = (msg->tag() == Message::Tag::Open) || (msg->tag() == Message::Tag::Close);
+        if (msg->tag() == Message::Tag::Close) {
+            ++interNodeClosedCount_;
+        }
+        // Connections of clients on this node are tracked through their ring
+        if (connection && (localPeers_.find(msg->source()) != localPeers_.end())) {
+            continue;
+        }
+        return msg;
+    }
+    return std::nullopt;
+}
+
+static TransportBuilder<ShmTransport> ShmTransportBuilder("shm");
+
+}  // namespace multio::transport
@@ -0,0 +1,99 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "eckit/io/Buffer.h"
+
+#include "multio/transport/ShmRing.h"
+#include "multio/transport/Transport.h"
+
+namespace multio::transport {
+
+/// Hybrid transport: messages between a client and a server on the same node go through a shared-memory ring per
+/// (client, server) pair, everything else through the inter-node transport (`inter-node`, "mpi" by default), which
+/// is configured by the same server configuration and also provides the peers and their node placement.
+///
+/// The client encodes the header and copies the payload straight into the ring slots, the server copies it once out of
+/// the slots into the payload buffer of the received message.
+///
+/// The server receives from the inter-node transport with tryReceive() on its receiving thread, between polls of the
+/// rings, so the inter-node transport is never used from more threads than on its own.
+class ShmTransport final : public Transport {
+public:
+    ShmTransport(const ComponentConfiguration& compConf);
+    ~ShmTransport();
+
+private:
+    void openConnections() override;
+    void closeConnections() override;
+
+    Message receive() override;
+
+    void abort(std::exception_ptr) override;
+
+    void send(const Message& msg) override;
+
+    void bufferedSend(const Message& msg) override;
+
+    const Peer& localPeer() const override;
+
+    void listen() override;
+
+    PeerList createServerPeers() const override;
+
+    std::set<Peer> nodeLocalPeers() const override;
+
+    void createPeers() const override;
+
+    void print(std::ostream& os) const override;
+
+    std::string ringName(const Peer& client, const Peer& server) const;
+
+    void writeToRing(ShmRing& ring, const Message& msg);
+    Message readFromRing(ShmRing& ring);
+
+    std::optional<Message> pollRings();
+    void attachRings();
+
+    std::optional<Message> receiveInterNode();
+
+    std::unique_ptr<Transport> interNode_;
+
+    const std::string segmentPrefix_;
+    const std::size_t slotSize_;
+    const std::size_t slotCount_;
+
+    const std::set<Peer> localPeers_;
+
+    // Client side: one ring per server on this node
+    std::map<Peer, std::unique_ptr<ShmRing>> outgoing_;
+    eckit::Buffer headerBuffer_;
+
+    // Server side: clients on this node whose ring has not been attached yet, and the attached rings
+    std::vector<Peer> unattached_;
+    std::vector<std::unique_ptr<ShmRing>> incoming_;
+    std::size_t nextRing_ = 0;
+    std::vector<char> headerBytes_;
+    std::size_t closedCount_ = 0;
+
+    // Server side: closes received by the inter-node transport, and the last close held back until it is done
+    std::size_t interNodeClosedCount_ = 0;
+    std::optional<Message> lastClose_;
+};
+
+}  // namespace multio::transport
@@ -99,6 +99,14 @@ void StreamPool::sendBuffer(const message::Peer& dest, int msg_tag) {
     statistics_.isendSize_ += sz;
 }
 
+void StreamPool::flushStream(const message::Peer& dest, int msg_tag) {
+    if (streams_.find(dest) == std::end(streams_)) {
+        return;
+    }
+    sendBuffer(dest, msg_tag);
+    streams_.erase(dest);
+}
+
 MpiBuffer& StreamPool::acquireAvailableBuffer(BufferStatus newStatus, std::ostream& os) {
     util::ScopedTiming(statistics_.waitTiming_);
 
@@ -25,6 +25,9 @@ public:
 
     void sendBuffer(const message::Peer& dest, int msg_tag);
 
+    /// Sends the pending stream to dest, if any, and starts a new one on the next message
+    void flushStream(const message::Peer& dest, int msg_tag);
+
     MpiBuffer& acquireAvailableBuffer(BufferStatus newStatus, std::ostream& os = eckit::Log::debug<LibMultio>());
 
     void waitAll();
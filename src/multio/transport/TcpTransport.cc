@@ -10,48 +10,166 @@
 
 #include "TcpTransport.h"
 
+#include <sys/uio.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <poll.h>
+#endif
+
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include "eckit/config/LibEcKit.h"
 #include "eckit/config/LocalConfiguration.h"
-#include "eckit/log/Plural.h"
 #include "eckit/maths/Functions.h"
 #include "eckit/runtime/Main.h"
 #include "eckit/serialisation/MemoryStream.h"
+#include "eckit/serialisation/ResizableMemoryStream.h"
 
 namespace multio::transport {
 
 namespace {
-Message decodeMessage(eckit::Stream& stream) {
-    unsigned t;
-    stream >> t;
-
-    std::string src_grp;
-    stream >> src_grp;
-    size_t src_id;
-    stream >> src_id;
 
-    std::string dest_grp;
-    stream >> dest_grp;
-    size_t dest_id;
-    stream >> dest_id;
+const size_t defaultBatchSize = 1024 * 1024;
+const size_t defaultReaderThreads = 1;
+const size_t defaultQueueSize = 1024;
+const int pollTimeoutMs = 100;
 
-    std::string fieldId;
-    stream >> fieldId;
+struct TcpFrame {
+    std::uint64_t headerSize;
+    std::uint64_t payloadSize;
+};
 
-    unsigned long sz;
-    stream >> sz;
+void writeAll(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        auto written = ::writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw eckit::FailedSystemCall("writev", Here());
+        }
 
-    eckit::Buffer buffer(sz);
-    stream >> buffer;
+        // Skip what has been written and carry on with the rest
+        auto n = static_cast<size_t>(written);
+        while ((count > 0) && (n >= iov->iov_len)) {
+            n -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+}
 
-    return Message{Message::Header{static_cast<Message::Tag>(t), TcpPeer{src_grp, src_id}, TcpPeer{dest_grp, dest_id},
-                                   std::move(fieldId)},
-                   std::move(buffer)};
+void readAll(eckit::net::TCPSocket& socket, void* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (socket.read(data, static_cast<long>(size)) != static_cast<long>(size)) {
+        throw TransportException("Connection closed while reading a message", Here());
+    }
 }
-}  // namespace
 
+/// Waits for readable sockets: epoll on Linux, poll elsewhere
+class SocketPoller {
+public:
+#if defined(__linux__)
+    SocketPoller() : fd_{::epoll_create1(EPOLL_CLOEXEC)} {
+        if (fd_ < 0) {
+            throw eckit::FailedSystemCall("epoll_create1", Here());
+        }
+    }
+
+    ~SocketPoller() { ::close(fd_); }
+
+    void add(int fd) {
+        struct epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (::epoll_ctl(fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            throw eckit::FailedSystemCall("epoll_ctl", Here());
+        }
+    }
+
+    void remove(int fd) { ::epoll_ctl(fd_, EPOLL_CTL_DEL, fd, nullptr); }
+
+    /// @return readable descriptors, empty after the timeout
+    std::vector<int> wait(int timeoutMs) {
+        struct epoll_event events[maxEvents];
+        auto n = ::epoll_wait(fd_, events, maxEvents, timeoutMs);
+        if (n < 0) {
+            if (errno == EINTR) {
+                return {};
+            }
+            throw eckit::FailedSystemCall("epoll_wait", Here());
+        }
+
+        std::vector<int> ready;
+        for (int i = 0; i < n; ++i) {
+            ready.push_back(events[i].data.fd);
+        }
+        return ready;
+    }
+
+private:
+    static constexpr int maxEvents = 64;
+
+    int fd_;
+#else
+    void add(int fd) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        fds_.push_back(fd);
+    }
+
+    void remove(int fd) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        fds_.erase(std::remove(fds_.begin(), fds_.end(), fd), fds_.end());
+    }
+
+    /// @return readable descriptors, empty after the timeout
+    std::vector<int> wait(int timeoutMs) {
+        std::vector<struct pollfd> pfds;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            for (auto fd : fds_) {
+                pfds.push_back(pollfd{fd, POLLIN, 0});
+            }
+        }
+        auto n = ::poll(pfds.data(), pfds.size(), timeoutMs);
+        if (n < 0) {
+            if (errno == EINTR) {
+                return {};
+            }
+            throw eckit::FailedSystemCall("poll", Here());
+        }
+
+        std::vector<int> ready;
+        for (const auto& pfd : pfds) {
+            if (pfd.revents != 0) {
+                ready.push_back(pfd.fd);
+            }
+        }
+        return ready;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int> fds_;
+#endif
+};
+
+}  // namespace
 
 TcpPeer::TcpPeer(const std::string& host, size_t port) : Peer{host, port} {}
 TcpPeer::TcpPeer(const std::string& host, int port) : Peer{host, static_cast<size_t>(port)} {}
@@ -64,24 +182,41 @@ size_t TcpPeer::port() const {
     return id_;
 }
 
-struct Connection {
-    eckit::Select& select_;
-    eckit::net::TCPSocket socket_;
+struct TcpOutgoing {
+    TcpOutgoing(std::unique_ptr<eckit::net::TCPSocket>&& s, size_t batchSize) :
+        socket{std::move(s)}, batch{batchSize} {}
 
-    Connection(eckit::Select& select, eckit::net::TCPSocket& socket) : select_{select}, socket_{socket} {
-        select_.add(socket_);
+    void encodeHeader(const Message& msg) {
+        eckit::ResizableMemoryStream stream{header};
+        msg.header().encode(stream);
+        headerSize = static_cast<size_t>(stream.bytesWritten());
     }
 
-    ~Connection() {
-        select_.remove(socket_);
-        socket_.close();
-    }
+    std::unique_ptr<eckit::net::TCPSocket> socket;
+
+    std::mutex mutex;
 
-    bool ready() { return select_.set(socket_); }
+    eckit::Buffer header{4096};
+    size_t headerSize = 0;
+
+    eckit::Buffer batch;
+    size_t batched = 0;
+};
+
+struct TcpReader {
+    SocketPoller poller;
+
+    std::mutex mutex;
+    std::map<int, std::unique_ptr<eckit::net::TCPSocket>> connections;
+
+    std::thread thread;
 };
 
 TcpTransport::TcpTransport(const ComponentConfiguration& compConf) :
-    Transport(compConf), local_{"localhost", compConf.parsedConfig().getUnsigned("local_port")} {
+    Transport(compConf),
+    local_{"localhost", compConf.parsedConfig().getUnsigned("local_port")},
+    batchSize_{compConf.parsedConfig().getUnsigned("batch-size", defaultBatchSize)},
+    received_{defaultQueueSize} {
     auto serverConfigs = compConf.parsedConfig().getSubConfigurations("servers");
     eckit::Log::debug() << " *** TcpTransport::constructor" << std::endl;
 
@@ -92,16 +227,15 @@ TcpTransport::TcpTransport(const ComponentConfiguration& compConf) :
         if (amIServer(host, ports)) {
             server_ = std::make_unique<eckit::net::TCPServer>(static_cast<int>(local_.port()),
                                                               eckit::net::SocketOptions::server());
-            select_.add(*server_);
         }
         else {
             // TODO: assert that (local_.host(), local_.port()) is in the list of clients
             for (const auto port : ports) {
                 try {
                     eckit::net::TCPClient client;
-                    std::unique_ptr<eckit::net::TCPSocket> socket
-                        = std::make_unique<eckit::net::TCPSocket>(client.connect(host, port, 5, 10));
-                    outgoing_.emplace(TcpPeer{host, port}, std::move(socket));
+                    auto socket = std::make_unique<eckit::net::TCPSocket>(client.connect(host, port, 5, 10));
+                    outgoing_.emplace(TcpPeer{host, port},
+                                      std::make_unique<TcpOutgoing>(std::move(socket), batchSize_));
                 }
                 catch (eckit::TooManyRetries& e) {
                     eckit::Log::error() << "Failed to establish connection to host: " << host << ", port: " << port
@@ -110,6 +244,30 @@ TcpTransport::TcpTransport(const ComponentConfiguration& compConf) :
             }
         }
     }
+
+    if (server_) {
+        serverFd_ = server_->socket();
+
+        auto readerCount
+            = std::max<size_t>(compConf.parsedConfig().getUnsigned("reader-threads", defaultReaderThreads), 1);
+        for (size_t i = 0; i < readerCount; ++i) {
+            readers_.emplace_back(std::make_unique<TcpReader>());
+        }
+        // The first reader also accepts connections and hands them out round robin
+        readers_.front()->poller.add(serverFd_);
+        for (auto& reader : readers_) {
+            reader->thread = std::thread([this, r = reader.get()]() { readLoop(*r); });
+        }
+    }
+}
+
+TcpTransport::~TcpTransport() {
+    stopReaders_ = true;
+    for (auto& reader : readers_) {
+        if (reader->thread.joinable()) {
+            reader->thread.join();
+        }
+    }
 }
 
 void TcpTransport::openConnections() {
@@ -126,39 +284,34 @@ void TcpTransport::closeConnections() {
     }
 }
 
-Message TcpTransport::nextMessage(eckit::net::TCPSocket& socket) const {
-    size_t size;
-    socket.read(&size, sizeof(size));
+Message TcpTransport::nextMessage(eckit::net::TCPSocket& socket, std::vector<char>& header) const {
+    TcpFrame frame;
+    readAll(socket, &frame, sizeof(frame));
+
+    header.resize(frame.headerSize);
+    readAll(socket, header.data(), header.size());
 
-    eckit::Buffer buffer{size};
-    socket.read(buffer, static_cast<long>(size));
+    eckit::Buffer payload{frame.payloadSize};
+    readAll(socket, payload.data(), frame.payloadSize);
 
-    eckit::MemoryStream stream{buffer};
+    eckit::MemoryStream stream{header.data(), header.size()};
 
-    return decodeMessage(stream);
+    return Message{Message::Header::decode(stream), std::move(payload)};
 }
 
 Message TcpTransport::receive() {
-    waitForEvent();
-
-    for (auto it = begin(incoming_); it != end(incoming_); ++it) {
-        if (not(*it)->ready()) {
-            continue;
-        }
-
-        auto msg = nextMessage((*it)->socket_);
-
-        if (msg.tag() == Message::Tag::Close) {
-            incoming_.erase(it);
-        }
-        else {
-            std::swap(*it, incoming_[incoming_.size() - 1]);
-        }
+    Message msg;
+    received_.pop(msg);
+    queuedMessages_.fetch_sub(1, std::memory_order_relaxed);
+    return msg;
+}
 
-        return msg;
+std::optional<Message> TcpTransport::tryReceive() {
+    // Messages are counted right before they are pushed, so this does not wait for the next message
+    if (queuedMessages_.load(std::memory_order_acquire) == 0) {
+        return std::nullopt;
     }
-
-    throw eckit::SeriousBug("No message received");
+    return receive();
 }
 
 void TcpTransport::abort(std::exception_ptr) {
@@ -166,25 +319,68 @@ void TcpTransport::abort(std::exception_ptr) {
 }
 
 void TcpTransport::send(const Message& msg) {
-    std::lock_guard<std::mutex> lock{mutex_};
+    auto& conn = *outgoing_.at(msg.destination());
+    std::lock_guard<std::mutex> lock{conn.mutex};
 
-    const auto& socket = outgoing_.at(msg.destination());
+    flush(conn);
+    conn.encodeHeader(msg);
+    write(conn, msg);
+}
+
+void TcpTransport::bufferedSend(const Message& msg) {
+    auto& conn = *outgoing_.at(msg.destination());
+    std::lock_guard<std::mutex> lock{conn.mutex};
+
+    conn.encodeHeader(msg);
+    const auto frameSize = sizeof(TcpFrame) + conn.headerSize + msg.size();
 
-    // Add 4K for header/footer etc. Should be plenty
-    eckit::Buffer buffer{eckit::round(msg.size(), 8) + 4096};
+    // Only batch messages for which saving a system call is worth the extra copy
+    if (2 * frameSize > batchSize_) {
+        flush(conn);
+        write(conn, msg);
+        return;
+    }
 
-    eckit::MemoryStream stream{buffer};
+    if (conn.batched + frameSize > batchSize_) {
+        flush(conn);
+    }
 
-    msg.encode(stream);
+    auto* dest = static_cast<char*>(conn.batch.data()) + conn.batched;
+    TcpFrame frame{conn.headerSize, msg.size()};
+    std::memcpy(dest, &frame, sizeof(frame));
+    std::memcpy(dest + sizeof(frame), conn.header.data(), conn.headerSize);
+    if (msg.size() > 0) {
+        std::memcpy(dest + sizeof(frame) + conn.headerSize, msg.payload().data(), msg.size());
+    }
+    conn.batched += frameSize;
+}
 
-    auto size = stream.bytesWritten();
-    socket->write(&size, sizeof(size));
+void TcpTransport::write(TcpOutgoing& conn, const Message& msg) {
+    // Frame, header and payload in one system call
+    TcpFrame frame{conn.headerSize, msg.size()};
+    struct iovec iov[3];
+    iov[0] = {&frame, sizeof(frame)};
+    iov[1] = {conn.header.data(), conn.headerSize};
+    iov[2] = {const_cast<void*>(msg.payload().data()), msg.size()};
+    writeAll(conn.socket->socket(), iov, msg.size() > 0 ? 3 : 2);
 
-    socket->write(buffer, static_cast<int>(size));
+    std::lock_guard<std::mutex> lock{mutex_};
+    ++statistics_.sendCount_;
+    statistics_.sendSize_ += sizeof(frame) + conn.headerSize + msg.size();
 }
 
-void TcpTransport::bufferedSend(const Message&) {
-    throw eckit::NotImplemented{Here()};
+void TcpTransport::flush(TcpOutgoing& conn) {
+    if (conn.batched == 0) {
+        return;
+    }
+
+    struct iovec iov = {conn.batch.data(), conn.batched};
+    writeAll(conn.socket->socket(), &iov, 1);
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    ++statistics_.isendCount_;
+    statistics_.isendSize_ += conn.batched;
+    conn.batched = 0;
 }
 
 const Peer& TcpTransport::localPeer() const {
@@ -203,6 +399,20 @@ PeerList TcpTransport::createServerPeers() const {
     return serverPeers;
 }
 
+std::set<Peer> TcpTransport::nodeLocalPeers() const {
+    const auto hostname = eckit::Main::hostname();
+
+    std::set<Peer> localPeers;
+    for (const auto* peers : {&clientPeers(), &serverPeers()}) {
+        for (const auto& peer : *peers) {
+            if ((peer->group() == "localhost") || (peer->group() == hostname)) {
+                localPeers.insert(*peer);
+            }
+        }
+    }
+    return localPeers;
+}
+
 void TcpTransport::createPeers() const {
     // Client peers
     for (auto cfg : compConf_.parsedConfig().getSubConfigurations("clients")) {
@@ -225,24 +435,51 @@ void TcpTransport::print(std::ostream& os) const {
     os << "TcpTransport()";
 }
 
-bool TcpTransport::acceptConnection() {
-    if (not select_.set(*server_)) {
-        return false;
-    }
+void TcpTransport::readLoop(TcpReader& reader) {
+    try {
+        std::vector<char> header;
+        while (!stopReaders_) {
+            for (auto fd : reader.poller.wait(pollTimeoutMs)) {
+                if (fd == serverFd_) {
+                    acceptConnection();
+                    continue;
+                }
 
-    eckit::net::TCPSocket socket{server_->accept()};
-    incoming_.emplace_back(std::make_unique<Connection>(select_, socket));
+                eckit::net::TCPSocket* socket = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock{reader.mutex};
+                    socket = reader.connections.at(fd).get();
+                }
 
-    return true;
-}
+                auto msg = nextMessage(*socket, header);
 
-void TcpTransport::waitForEvent() {
-    do {
-        while (not select_.ready(5)) {
-            eckit::Log::info() << "Waiting... There are " << eckit::Plural(incoming_.size(), "connection")
-                               << " still active" << std::endl;
+                // No more messages on this connection
+                if (msg.tag() == Message::Tag::Close) {
+                    reader.poller.remove(fd);
+                    std::lock_guard<std::mutex> lock{reader.mutex};
+                    reader.connections.erase(fd);
+                }
+
+                queuedMessages_.fetch_add(1, std::memory_order_release);
+                received_.emplace(std::move(msg));
+            }
         }
-    } while (acceptConnection());
+    }
+    catch (...) {
+        received_.interrupt(std::current_exception());
+    }
+}
+
+void TcpTransport::acceptConnection() {
+    auto socket = std::make_unique<eckit::net::TCPSocket>(server_->accept());
+    auto fd = socket->socket();
+
+    auto& reader = *readers_[nextReader_++ % readers_.size()];
+    {
+        std::lock_guard<std::mutex> lock{reader.mutex};
+        reader.connections.emplace(fd, std::move(socket));
+    }
+    reader.poller.add(fd);
 }
 
 bool TcpTransport::amIServer(const std::string& host, std::vector<size_t> ports) {
@@ -16,11 +16,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <vector>
 
-#include "eckit/io/Select.h"
+#include "eckit/container/Queue.h"
 #include "eckit/net/TCPClient.h"
 #include "eckit/net/TCPServer.h"
 
@@ -44,17 +46,24 @@ public:
     size_t port() const;
 };
 
-struct Connection;
+struct TcpOutgoing;
+struct TcpReader;
 
+/// Messages are framed as header size, payload size, encoded header and raw payload, so that a message is written with
+/// a single scatter/gather call and the payload is read straight into the buffer of the received message.
+/// Incoming connections are spread over `reader-threads` threads, each polling its own connections.
+/// bufferedSend batches messages per connection up to `batch-size` bytes.
 class TcpTransport final : public Transport {
 public:
     TcpTransport(const ComponentConfiguration& compConf);
+    ~TcpTransport();
 
 private:
     void openConnections() override;
     void closeConnections() override;
 
     Message receive() override;
+    std::optional<Message> tryReceive() override;
 
     void abort(std::exception_ptr) override;
 
@@ -66,25 +75,38 @@ private:
 
     PeerList createServerPeers() const override;
 
+    std::set<Peer> nodeLocalPeers() const override;
+
     void createPeers() const override;
 
     void print(std::ostream& os) const override;
 
-    Message nextMessage(eckit::net::TCPSocket& socket) const;
+    void write(TcpOutgoing& conn, const Message& msg);
+    void flush(TcpOutgoing& conn);
+
+    Message nextMessage(eckit::net::TCPSocket& socket, std::vector<char>& header) const;
 
-    bool acceptConnection();
-    void waitForEvent();
+    void readLoop(TcpReader& reader);
+    void acceptConnection();
 
     bool amIServer(const std::string& host, std::vector<size_t> ports);
 
     TcpPeer local_;
 
-    std::map<Peer, const std::unique_ptr<eckit::net::TCPSocket>> outgoing_;
+    const size_t batchSize_;
 
-    eckit::Select select_;
+    std::map<Peer, std::unique_ptr<TcpOutgoing>> outgoing_;
 
     std::unique_ptr<eckit::net::TCPServer> server_;
-    std::vector<std::unique_ptr<Connection>> incoming_;
+    int serverFd_ = -1;
+
+    std::vector<std::unique_ptr<TcpReader>> readers_;
+    size_t nextReader_ = 0;
+    std::atomic<bool> stopReaders_{false};
+
+    eckit::Queue<Message> received_;
+    // Messages pushed to received_ and not popped yet
+    std::atomic<size_t> queuedMessages_{0};
 };
 
 }  // namespace multio::transport
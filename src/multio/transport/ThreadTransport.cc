@@ -10,6 +10,9 @@
 
 #include "ThreadTransport.h"
 
+#include <atomic>
+#include <set>
+
 #include "eckit/config/LibEcKit.h"
 #include "eckit/config/Resource.h"
 #include "eckit/exception/Exceptions.h"
@@ -18,6 +21,19 @@
 
 namespace multio::transport {
 
+namespace {
+
+const std::size_t defaultBatchSize = 64;
+
+// Keys the thread-local state, a later transport may be allocated at the address of a destroyed one
+std::atomic<std::size_t> transportCount{0};
+
+// Transports not destroyed yet, threads drop their entries for the others
+std::mutex liveMutex;
+std::set<std::size_t> liveTransports;
+
+}  // namespace
+
 ThreadPeer::ThreadPeer(std::thread t) :
     Peer{"thread", std::hash<std::thread::id>{}(t.get_id())}, thread_{std::move(t)} {}
 
@@ -27,14 +43,33 @@ void ThreadPeer::join() {
 
 ThreadTransport::ThreadTransport(const ComponentConfiguration& compConf) :
     Transport(compConf),
-    messageQueueSize_(eckit::Resource<size_t>("multioMessageQueueSize;$MULTIO_MESSAGE_QUEUE_SIZE", 1024)) {}
+    id_{transportCount++},
+    messageQueueSize_(eckit::Resource<size_t>("multioMessageQueueSize;$MULTIO_MESSAGE_QUEUE_SIZE", 1024)),
+    batchSize_{compConf.parsedConfig().getUnsigned("batch-messages", defaultBatchSize)} {
+    ASSERT(batchSize_ > 0);
+
+    std::lock_guard<std::mutex> lock{liveMutex};
+    liveTransports.insert(id_);
+}
+
+ThreadTransport::~ThreadTransport() {
+    std::lock_guard<std::mutex> lock{liveMutex};
+    liveTransports.erase(id_);
+}
 
 void ThreadTransport::openConnections() {
-    throw eckit::NotImplemented{Here()};
+    for (const auto& server : createServerPeers()) {
+        send(Message{Message::Header{Message::Tag::Open, localPeer(), *server}});
+    }
 }
 
 void ThreadTransport::closeConnections() {
-    throw eckit::NotImplemented{Here()};
+    for (auto& out : threadState().outboxes) {
+        flush(out.second);
+    }
+    for (const auto& server : createServerPeers()) {
+        send(Message{Message::Header{Message::Tag::Close, localPeer(), *server}});
+    }
 }
 
 
@@ -42,11 +77,22 @@ Message ThreadTransport::receive() {
 
     const Peer& receiver = localPeer();
 
-    auto& queue = receiveQueue(receiver);
+    auto& state = threadState();
+    if (state.inbox == nullptr) {
+        state.inbox = &receiveQueue(receiver);
 
-    Message msg;
+        std::lock_guard<std::mutex> lock{serversMutex_};
+        servers_.push_back(receiver);
+        serversCv_.notify_all();
+    }
+
+    if (state.next == state.received.size()) {
+        state.received = state.inbox->queue.pop();
+        state.next = 0;
+    }
+
+    Message msg = std::move(state.received[state.next++]);
 
-    ASSERT(queue.pop(msg) >= 0);
     ASSERT(msg.destination() == receiver);
 
     return msg;
@@ -57,11 +103,17 @@ void ThreadTransport::abort(std::exception_ptr) {
 }
 
 void ThreadTransport::send(const Message& msg) {
-    receiveQueue(msg.destination()).push(msg);
+    auto& out = outbox(msg.destination());
+    out.batch.push_back(msg);
+    flush(out);
 }
 
-void ThreadTransport::bufferedSend(const Message&) {
-    throw eckit::NotImplemented{Here()};
+void ThreadTransport::bufferedSend(const Message& msg) {
+    auto& out = outbox(msg.destination());
+    out.batch.push_back(msg);
+    if (out.batch.size() >= batchSize_) {
+        flush(out);
+    }
 }
 
 const Peer& ThreadTransport::localPeer() const {
@@ -70,20 +122,59 @@ const Peer& ThreadTransport::localPeer() const {
 }
 
 PeerList ThreadTransport::createServerPeers() const {
-    throw eckit::NotImplemented{Here()};
+    const auto expected = compConf_.parsedConfig().getUnsigned("serverCount", 0);
+
+    std::unique_lock<std::mutex> lock{serversMutex_};
+    serversCv_.wait(lock, [&]() { return servers_.size() >= expected; });
+
+    PeerList serverPeers;
+    for (const auto& server : servers_) {
+        serverPeers.emplace_back(std::make_unique<Peer>(server));
+    }
+    return serverPeers;
 }
 
 void ThreadTransport::createPeers() const {
     // Hack to work around the very different logic of creating ThreadPeers.
     // See multio-hammer.cc: MultioHammer::executeThread
-    clientPeers_ = PeerList(compConf_.parsedConfig().getUnsigned("clientCount"));
+    std::lock_guard<std::mutex> lock{serversMutex_};
+    if (clientPeers_.empty()) {
+        clientPeers_ = PeerList(compConf_.parsedConfig().getUnsigned("clientCount"));
+    }
 }
 
 void ThreadTransport::print(std::ostream& os) const {
-    os << "ThreadTransport(number of queues = " << queues_.size() << ")";
+    os << "ThreadTransport(number of queues = " << queues_.size() << ", batch size = " << batchSize_ << ")";
+}
+
+ThreadTransport::ThreadState& ThreadTransport::threadState() const {
+    // The states are owned by the transport and released with it, threads only cache where to find theirs
+    thread_local std::map<std::size_t, ThreadState*> states;
+
+    auto it = states.find(id_);
+    if (it != states.end()) {
+        return *it->second;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{liveMutex};
+        for (auto entry = states.begin(); entry != states.end();) {
+            if (liveTransports.find(entry->first) == liveTransports.end()) {
+                entry = states.erase(entry);
+            }
+            else {
+                ++entry;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock{threadStatesMutex_};
+    auto& state = *threadStates_.emplace_back(std::make_unique<ThreadState>());
+    states.emplace(id_, &state);
+    return state;
 }
 
-eckit::Queue<Message>& ThreadTransport::receiveQueue(Peer dest) {
+ThreadTransport::Inbox& ThreadTransport::receiveQueue(const Peer& dest) {
 
     std::unique_lock<std::mutex> locker(mutex_);
 
@@ -92,13 +183,32 @@ eckit::Queue<Message>& ThreadTransport::receiveQueue(Peer dest) {
         return *qitr->second;
     }
 
-    auto q = queues_.emplace(dest, std::make_unique<eckit::Queue<Message>>(messageQueueSize_)).first;
+    auto q = queues_.emplace(dest, std::make_unique<Inbox>(messageQueueSize_)).first;
 
     eckit::Log::debug<LibMultio>() << "ADD QUEUE for " << dest << " --- " << q->second.get() << std::endl;
 
     return *q->second.get();
 }
 
+ThreadTransport::Outbox& ThreadTransport::outbox(const Peer& dest) {
+    auto& outboxes = threadState().outboxes;
+
+    auto it = outboxes.find(dest);
+    if (it == outboxes.end()) {
+        // Only the first message to a destination looks up its queue under the lock
+        it = outboxes.emplace(dest, Outbox{&receiveQueue(dest), Batch{}}).first;
+    }
+    return it->second;
+}
+
+void ThreadTransport::flush(Outbox& out) {
+    if (out.batch.empty()) {
+        return;
+    }
+    out.inbox->queue.push(std::move(out.batch));
+    out.batch.clear();
+}
+
 static TransportBuilder<ThreadTransport> ThreadTransportBuilder("thread");
 
 }  // namespace multio::transport
@@ -16,13 +16,15 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
-
-#include "eckit/container/Queue.h"
+#include <vector>
 
 #include "multio/transport/Transport.h"
+#include "multio/util/MpscQueue.h"
 #include "multio/util/ScopedThread.h"
 
 namespace multio::transport {
@@ -37,15 +39,46 @@ private:
     util::ScopedThread thread_;
 };
 
+/// In-process transport between client and server threads. Every server thread owns a lock-free queue that any number
+/// of client threads push to. Messages are handed over in batches: each sending thread collects the messages for a
+/// destination in a thread-local batch. `bufferedSend` pushes it once it holds `batch-messages` messages, `send` pushes
+/// it immediately, so the ordering per destination is kept.
+///
+/// Server threads register on their first call to `receive`. If the configuration contains `serverCount`,
+/// `createServerPeers` (and hence `openConnections` and `closeConnections`) waits for that many servers.
 class ThreadTransport final : public Transport {
 public:
     ThreadTransport(const ComponentConfiguration& compConf);
+    ~ThreadTransport();
 
     Message receive() override;
 
     void abort(std::exception_ptr) override;
 
 private:
+    using Batch = std::vector<Message>;
+
+    struct Inbox {
+        explicit Inbox(std::size_t capacity) : queue{capacity} {}
+        util::MpscQueue<Batch> queue;
+    };
+
+    struct Outbox {
+        Inbox* inbox;
+        Batch batch;
+    };
+
+    /// Per thread and transport, owned by the transport
+    struct ThreadState {
+        // Receiving side: own inbox and the batch currently being handed out
+        Inbox* inbox = nullptr;
+        Batch received;
+        std::size_t next = 0;
+
+        // Sending side: pending batch per destination
+        std::map<Peer, Outbox> outboxes;
+    };
+
     void openConnections() override;
     void closeConnections() override;
 
@@ -61,13 +94,27 @@ private:
 
     void createPeers() const override;
 
-    eckit::Queue<Message>& receiveQueue(Peer to);
+    ThreadState& threadState() const;
+
+    Inbox& receiveQueue(const Peer& to);
+
+    Outbox& outbox(const Peer& to);
+
+    void flush(Outbox& out);
+
+    const std::size_t id_;
+
+    std::map<Peer, std::unique_ptr<Inbox>> queues_;
 
-    std::map<Peer, std::unique_ptr<eckit::Queue<Message>>> queues_;
+    std::size_t messageQueueSize_;
+    std::size_t batchSize_;
 
-    std::mutex mutex_;
+    mutable std::mutex serversMutex_;
+    mutable std::condition_variable serversCv_;
+    std::vector<Peer> servers_;
 
-    size_t messageQueueSize_;
+    mutable std::mutex threadStatesMutex_;
+    mutable std::vector<std::unique_ptr<ThreadState>> threadStates_;
 };
 
 }  // namespace multio::transport
@@ -11,6 +11,7 @@
 #include "Transport.h"
 
 #include <iostream>
+#include <sstream>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/log/Log.h"
@@ -47,6 +48,16 @@ Transport::~Transport() = default;
 
 void Transport::listen() {}
 
+std::optional<Message> Transport::tryReceive() {
+    std::ostringstream oss;
+    oss << *this << " does not support receiving without waiting";
+    throw TransportException(oss.str(), Here());
+}
+
+std::set<Peer> Transport::nodeLocalPeers() const {
+    return {};
+}
+
 const PeerList& Transport::clientPeers() const {
     if (peersMissing()) {
         createPeers();
@@ -19,6 +19,8 @@
 #include <iosfwd>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <string>
 
 #include "eckit/exception/Exceptions.h"
@@ -49,6 +51,10 @@ public:  // methods
 
     virtual Message receive() = 0;
 
+    /// Returns a received message if one is available, without waiting for the next one. Must be called from the
+    /// thread that calls receive(), for transports which combine several sources on that thread.
+    virtual std::optional<Message> tryReceive();
+
     virtual void abort(std::exception_ptr) = 0;
 
     virtual void send(const Message& message) = 0;
@@ -61,6 +67,10 @@ public:  // methods
 
     virtual PeerList createServerPeers() const = 0;
 
+    /// Client and server peers running on the same node as this process (including itself). Transports that have to
+    /// exchange host information do so collectively, so all peers must call this at the same point.
+    virtual std::set<Peer> nodeLocalPeers() const;
+
     const PeerList& clientPeers() const;
     const PeerList& serverPeers() const;
 
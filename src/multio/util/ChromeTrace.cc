@@ -0,0 +1,147 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/util/ChromeTrace.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+
+#include "multio/util/TraceEventIds.h"
+
+namespace multio::util {
+
+namespace {
+
+const char* eventName(uint64_t traceEventId) {
+    switch (traceEventId << 56) {
+        case MULTIO_PEAK_VIRTUAL_MEMORY:
+            return "peak virtual memory";
+        case MULTIO_VIRTUAL_MEMORY:
+            return "virtual memory";
+        case MULTIO_LOCKED_VIRTUAL_MEMORY:
+            return "locked virtual memory";
+        case MULTIO_PINNED_VIRTUAL_MEMORY:
+            return "pinned virtual memory";
+        case MULTIO_MAXIMUM_RESIDENT_MEMORY:
+            return "maximum resident memory";
+        case MULTIO_RESIDENT_MEMORY:
+            return "resident memory";
+        case MULTIO_ANONIMOUS_RESIDENT_MEMORY:
+            return "anonymous resident memory";
+        case MULTIO_FILE_MAPPING_RESIDENT_MEMORY:
+            return "file mapping resident memory";
+        case MULTIO_SHARED_RESIDENT_MEMORY:
+            return "shared resident memory";
+        case MULTIO_DATA_VIRTUAL_MEMORY:
+            return "data virtual memory";
+        case MULTIO_STACK_VIRTUAL_MEMORY:
+            return "stack virtual memory";
+        case MULTIO_TEXT_SEGMENT_VIRTUAL_MEMORY:
+            return "text segment virtual memory";
+        case MULTIO_SHARED_LIBRARY_VIRTUAL_MEMORY:
+            return "shared library virtual memory";
+        case MULTIO_PAGE_TABLE_ENTRY_VIRTUAL_MEMORY:
+            return "page table entry virtual memory";
+        case MULTIO_SECOND_LEVEL_PAGE_TABLE_ENTRY_VIRTUAL_MEMORY:
+            return "second level page table entry virtual memory";
+        case MULTIO_SWAPPED_OUT_VIRTUAL_MEMORY:
+            return "swapped out virtual memory";
+        case MULTIO_HUGE_TABLE_MEMORY:
+            return "huge table memory";
+        case MULTIO_SPAN_RECEIVE:
+            return "receive";
+        case MULTIO_SPAN_DECODE:
+            return "decode";
+        case MULTIO_SPAN_DISPATCH:
+            return "dispatch";
+        case MULTIO_SPAN_ACTION:
+            return "action";
+        case MULTIO_SPAN_ENCODE:
+            return "encode";
+        case MULTIO_SPAN_SINK_WRITE:
+            return "sink write";
+        default:
+            return "unknown";
+    }
+}
+
+// Trace files are written as <path>_<rank>, the rank becomes the process id of the timeline
+long rankOf(const std::string& path) {
+    const auto pos = path.rfind('_');
+    if (pos == std::string::npos || pos + 1 == path.size()
+        || !std::all_of(path.begin() + pos + 1, path.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return 0;
+    }
+    return std::stol(path.substr(pos + 1));
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void writeChromeTrace(const std::vector<std::string>& inputs, std::ostream& out) {
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << std::fixed << std::setprecision(3);
+
+    const char* sep = "";
+    for (const auto& input : inputs) {
+        const auto pid = rankOf(input);
+
+        std::vector<std::pair<uint64_t, uint64_t>> events;  // (timestamp, event)
+        {
+            std::ifstream in{input, std::ios::binary};
+            uint64_t record[2];
+            while (in.read(reinterpret_cast<char*>(record), sizeof(record))) {
+                if (record[0] != 0) {
+                    events.emplace_back(record[1], record[0]);
+                }
+            }
+        }
+
+        // Chunks are written when they are full, threads can complete them out of order
+        std::stable_sort(events.begin(), events.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (const auto& [timestamp, event] : events) {
+            const auto traceEventId = event >> 56;
+            const auto ts = static_cast<double>(timestamp) * 1e-3;
+
+            out << sep;
+            sep = ",\n";
+
+            if ((event & (0xFFULL << 56)) >= MULTIO_SPAN_RECEIVE) {
+                const auto begin = (event & (0x1ULL << 48)) != 0;
+                const auto tid = (event >> 32) & 0xFFFFULL;
+                const auto fieldKey = event & 0xFFFFFFFFULL;
+                out << "{\"name\":\"" << eventName(traceEventId) << "\",\"cat\":\"multio\",\"ph\":\""
+                    << (begin ? "B" : "E") << "\",\"ts\":" << ts << ",\"pid\":" << pid << ",\"tid\":" << tid
+                    << ",\"args\":{\"field\":" << fieldKey << "}}";
+            }
+            else {
+                // Memory samples: value in bits 0-31, unit (B, KiB, MiB, GiB) in bits 32-47
+                const auto value = event & 0xFFFFFFFFULL;
+                const auto unit = (event >> 32) & 0xFFFFULL;
+                out << "{\"name\":\"" << eventName(traceEventId) << "\",\"cat\":\"memory\",\"ph\":\"C\",\"ts\":"
+                    << ts << ",\"pid\":" << pid << ",\"args\":{\"bytes\":" << (value << (10 * unit)) << "}}";
+            }
+        }
+    }
+
+    out << "\n]}\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
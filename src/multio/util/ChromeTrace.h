@@ -0,0 +1,28 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace multio::util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Writes the events of the given trace files in the Chrome trace event format, which is read by chrome://tracing and
+/// Perfetto. Spans become duration events per thread, memory samples become counters. Trace files are named
+/// <path>_<rank>, the rank becomes the process id of the timeline.
+void writeChromeTrace(const std::vector<std::string>& inputs, std::ostream& out);
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
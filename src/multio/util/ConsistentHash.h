@@ -0,0 +1,62 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "multio/util/Hash.h"
+
+namespace multio::util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// 64 bit FNV-1a over the binary representation of the values, finalised with the splitmix64 mixer so that the low
+// bits used for a server index are well distributed
+class FieldHash {
+public:
+    void add(const void* data, std::size_t size) { hash_ = fnv1a(data, size, hash_); }
+
+    template <typename T>
+    void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(&value, sizeof(T));
+    }
+
+    std::uint64_t value() const {
+        std::uint64_t h = hash_;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+private:
+    std::uint64_t hash_ = Fnv1a<std::uint64_t>::basis;
+};
+
+// Jump consistent hash (Lamping & Veach): when the number of buckets grows from n to n + 1, only the keys that move
+// to the new bucket change their assignment
+inline std::size_t jumpConsistentHash(std::uint64_t key, std::size_t buckets) {
+    std::int64_t b = -1;
+    std::int64_t j = 0;
+    while (j < static_cast<std::int64_t>(buckets)) {
+        b = j;
+        key = key * 2862933555777941757ULL + 1;
+        j = static_cast<std::int64_t>(static_cast<double>(b + 1)
+                                      * (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+    }
+    return static_cast<std::size_t>(b);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
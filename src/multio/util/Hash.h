@@ -0,0 +1,56 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace multio::util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// FNV-1a parameters for 32 and 64 bit hashes
+template <typename UInt>
+struct Fnv1a;
+
+template <>
+struct Fnv1a<std::uint32_t> {
+    static constexpr std::uint32_t basis = 2166136261u;
+    static constexpr std::uint32_t prime = 16777619u;
+};
+
+template <>
+struct Fnv1a<std::uint64_t> {
+    static constexpr std::uint64_t basis = 0xcbf29ce484222325ULL;
+    static constexpr std::uint64_t prime = 0x100000001b3ULL;
+};
+
+// FNV-1a over the given bytes, continuing from hash. Unlike std::hash it is the same on all runs, ranks and platforms,
+// so it can name files or identify fields across processes
+template <typename UInt = std::uint32_t>
+inline UInt fnv1a(const void* data, std::size_t size, UInt hash = Fnv1a<UInt>::basis) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= Fnv1a<UInt>::prime;
+    }
+    return hash;
+}
+
+template <typename UInt = std::uint32_t>
+inline UInt fnv1a(std::string_view s, UInt hash = Fnv1a<UInt>::basis) noexcept {
+    return fnv1a<UInt>(s.data(), s.size(), hash);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
@@ -0,0 +1,279 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/util/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+#include "eckit/config/Resource.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/log/Log.h"
+
+#include "multio/util/logfile_name.h"
+
+namespace multio::util {
+
+namespace {
+
+int highestBit(std::uint64_t v) {
+    int bit = -1;
+    while (v != 0) {
+        v >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+std::string withLabel(const std::string& labels, const std::string& label) {
+    return "{" + (labels.empty() ? label : labels + "," + label) + "}";
+}
+
+std::string formatSeconds(double seconds) {
+    std::ostringstream oss;
+    oss << std::setprecision(10) << seconds;
+    return oss.str();
+}
+
+std::string braced(const std::string& labels) {
+    return labels.empty() ? std::string{} : "{" + labels + "}";
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::size_t LatencyHistogram::index(std::uint64_t ns) {
+    if (ns < subBuckets) {
+        return static_cast<std::size_t>(ns);
+    }
+    const auto shift = static_cast<std::size_t>(highestBit(ns)) - subBucketBits;
+    const auto sub = static_cast<std::size_t>(ns >> shift) & (subBuckets - 1);
+    return (shift + 1) * subBuckets + sub;
+}
+
+double LatencyHistogram::upperBound(std::size_t index) {
+    if (index < subBuckets) {
+        return static_cast<double>(index + 1) * 1e-9;
+    }
+    const auto shift = static_cast<int>(index / subBuckets) - 1;
+    const auto sub = index % subBuckets;
+    return std::ldexp(static_cast<double>(subBuckets + sub + 1), shift) * 1e-9;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+    const auto ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(elapsed.count(), 0));
+    buckets_[index(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumNs_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::quantile(double q) const {
+    std::uint64_t total = 0;
+    for (const auto& b : buckets_) {
+        total += b.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+
+    const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        seen += bucketCount(i);
+        if (seen >= rank && seen > 0) {
+            return upperBound(i);
+        }
+    }
+    return upperBound(size - 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+Metrics::Metrics() :
+    path_{eckit::Resource<std::string>("multioMetricsDirectory;$MULTIO_METRICS_DIRECTORY", "")},
+    period_{static_cast<long>(eckit::Resource<long>("multioMetricsPeriod;$MULTIO_METRICS_PERIOD", 10))} {
+    if (!enabled()) {
+        return;
+    }
+
+    eckit::PathName{path_}.mkdir();
+    path_ += "/" + filename_prefix() + ".prom";
+    thread_ = std::thread{&Metrics::run, this};
+}
+
+Metrics::~Metrics() {
+    if (!enabled()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+        cv_.notify_all();
+    }
+    thread_.join();
+
+    try {
+        exportFile();
+    }
+    catch (const std::exception& e) {
+        eckit::Log::error() << "Writing metrics to " << path_ << " failed: " << e.what() << std::endl;
+    }
+}
+
+template <typename T>
+T& Metrics::find(std::map<std::string, Family<T>>& families, const std::string& name, const std::string& labels,
+                 const std::string& help) {
+    auto& family = families[name];
+    if (family.help.empty()) {
+        family.help = help;
+    }
+    auto& series = family.series[labels];
+    if (!series) {
+        series = std::make_unique<T>();
+    }
+    return *series;
+}
+
+LatencyHistogram& Metrics::histogram(const std::string& name, const std::string& labels, const std::string& help) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return find(histograms_, name, labels, help);
+}
+
+MetricsCounter& Metrics::counter(const std::string& name, const std::string& labels, const std::string& help) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return find(counters_, name, labels, help);
+}
+
+MetricsGauge& Metrics::gauge(const std::string& name, const std::string& labels, const std::string& help) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return find(gauges_, name, labels, help);
+}
+
+const LatencyHistogram* Metrics::findHistogram(const std::string& name, const std::string& labels) const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (auto family = histograms_.find(name); family != histograms_.end()) {
+        if (auto series = family->second.series.find(labels); series != family->second.series.end()) {
+            return series->second.get();
+        }
+    }
+    return nullptr;
+}
+
+void Metrics::write(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    for (const auto& [name, family] : histograms_) {
+        out << "# TYPE " << name << " histogram\n# HELP " << name << " " << family.help << "\n";
+        for (const auto& [labels, h] : family.series) {
+            // Only the upper bounds of non-empty buckets are written, the cumulative counts stay exact
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < LatencyHistogram::size; ++i) {
+                if (const auto n = h->bucketCount(i); n > 0) {
+                    cumulative += n;
+                    out << name << "_bucket"
+                        << withLabel(labels, "le=\"" + formatSeconds(LatencyHistogram::upperBound(i)) + "\"") << " "
+                        << cumulative << "\n";
+                }
+            }
+            out << name << "_bucket" << withLabel(labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+            out << name << "_count" << braced(labels) << " " << cumulative << "\n";
+            out << name << "_sum" << braced(labels) << " " << formatSeconds(h->sumSeconds()) << "\n";
+        }
+    }
+
+    for (const auto& [name, family] : counters_) {
+        out << "# TYPE " << name << " counter\n# HELP " << name << " " << family.help << "\n";
+        for (const auto& [labels, c] : family.series) {
+            out << name << "_total" << braced(labels) << " " << c->value() << "\n";
+        }
+    }
+
+    for (const auto& [name, family] : gauges_) {
+        out << "# TYPE " << name << " gauge\n# HELP " << name << " " << family.help << "\n";
+        for (const auto& [labels, g] : family.series) {
+            out << name << braced(labels) << " " << g->value() << "\n";
+        }
+    }
+
+    out << "# EOF\n";
+}
+
+void Metrics::run() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (!cv_.wait_for(lock, period_, [this]() { return stop_; })) {
+        lock.unlock();
+        try {
+            exportFile();
+        }
+        catch (const std::exception& e) {
+            eckit::Log::error() << "Writing metrics to " << path_ << " failed: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
+
+void Metrics::exportFile() const {
+    const auto tmp = path_ + ".tmp";
+    {
+        std::ofstream out{tmp};
+        write(out);
+        if (!out) {
+            throw eckit::FailedSystemCall("write " + tmp, Here());
+        }
+    }
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        throw eckit::FailedSystemCall("rename " + tmp, Here());
+    }
+}
+
+FieldLatency::FieldLatency(const std::string& plan, const std::string& stage) {
+    auto& metrics = Metrics::instance();
+    if (metrics.enabled()) {
+        histogram_ = &metrics.histogram(metricName, metricsLabel("plan", plan) + "," + metricsLabel("stage", stage),
+                                        "Time since the client wrote a field, at each stage of a plan");
+    }
+}
+
+void FieldLatency::record(std::int64_t originTime) const {
+    if (histogram_ && originTime != 0) {
+        const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+        histogram_->record(std::chrono::nanoseconds(now - originTime));
+    }
+}
+
+std::string metricsLabel(const std::string& key, const std::string& value) {
+    std::string label = key + "=\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            label += '\\';
+        }
+        label += (c == '\n') ? ' ' : c;
+    }
+    return label + "\"";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
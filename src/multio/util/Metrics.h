@@ -0,0 +1,190 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace multio::util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Latency histogram with log-linear buckets: each power of two of nanoseconds is split into 8 linear sub-buckets, so
+/// every value is resolved to within 12.5%. Recording is lock-free.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t subBucketBits = 3;
+    static constexpr std::size_t subBuckets = std::size_t{1} << subBucketBits;
+    static constexpr std::size_t size = (64 - subBucketBits + 1) * subBuckets;
+
+    void record(std::chrono::nanoseconds elapsed);
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    double sumSeconds() const { return static_cast<double>(sumNs_.load(std::memory_order_relaxed)) * 1e-9; }
+
+    std::uint64_t bucketCount(std::size_t index) const { return buckets_[index].load(std::memory_order_relaxed); }
+
+    /// Upper bound of the bucket with the quantile q (0 <= q <= 1), in seconds
+    double quantile(double q) const;
+
+    /// Exclusive upper bound of a bucket, in seconds
+    static double upperBound(std::size_t index);
+
+    static std::size_t index(std::uint64_t ns);
+
+private:
+    std::array<std::atomic<std::uint64_t>, size> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sumNs_{0};
+};
+
+class MetricsCounter {
+public:
+    void add(std::uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+
+    std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+class MetricsGauge {
+public:
+    void set(std::int64_t v) { value_.store(v, std::memory_order_relaxed); }
+
+    std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Process-wide registry of live metrics, exported in the OpenMetrics text format.
+ *
+ * Metrics are only collected if the resource multioMetricsDirectory ($MULTIO_METRICS_DIRECTORY) is set. Every
+ * multioMetricsPeriod ($MULTIO_METRICS_PERIOD, default 10) seconds and at exit, the metrics are written to
+ * <directory>/multio-<host>-<pid>.prom. The file is replaced atomically, so it can be scraped while the run goes on,
+ * e.g. by the textfile collector of the Prometheus node exporter.
+ *
+ * Series are identified by their name and labels, e.g. histogram("multio_action_latency_seconds",
+ * R"(plan="p",action="sink")"). Returned references stay valid for the lifetime of the registry.
+ */
+class Metrics {
+public:
+    static Metrics& instance();
+
+    bool enabled() const { return !path_.empty(); }
+
+    LatencyHistogram& histogram(const std::string& name, const std::string& labels, const std::string& help);
+
+    MetricsCounter& counter(const std::string& name, const std::string& labels, const std::string& help);
+
+    MetricsGauge& gauge(const std::string& name, const std::string& labels, const std::string& help);
+
+    /// Histogram of a series if it exists, nullptr otherwise
+    const LatencyHistogram* findHistogram(const std::string& name, const std::string& labels) const;
+
+    void write(std::ostream& out) const;
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+private:  // methods
+    Metrics();
+
+    ~Metrics();
+
+    void run();
+
+    void exportFile() const;
+
+private:  // members
+    template <typename T>
+    struct Family {
+        std::string help;
+        std::map<std::string, std::unique_ptr<T>> series;
+    };
+
+    template <typename T>
+    static T& find(std::map<std::string, Family<T>>& families, const std::string& name, const std::string& labels,
+                   const std::string& help);
+
+    std::string path_;
+    std::chrono::seconds period_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family<LatencyHistogram>> histograms_;
+    std::map<std::string, Family<MetricsCounter>> counters_;
+    std::map<std::string, Family<MetricsGauge>> gauges_;
+
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Formats a label as key="value", escaping the value
+std::string metricsLabel(const std::string& key, const std::string& value);
+
+/**
+ * Age of fields at a stage of a plan, measured from the moment the client wrote them (see message::Message::Origin),
+ * recorded as multio_field_latency_seconds{plan,stage}. Nothing is recorded if metrics are disabled.
+ */
+class FieldLatency {
+public:
+    static constexpr const char* metricName = "multio_field_latency_seconds";
+
+    FieldLatency(const std::string& plan, const std::string& stage);
+
+    /// Records the age of a field written at originTime (nanoseconds of the system clock), ignored if 0
+    void record(std::int64_t originTime) const;
+
+private:
+    LatencyHistogram* histogram_ = nullptr;
+};
+
+/// Records the lifetime of the scope into a histogram, if any
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram* histogram) :
+        histogram_{histogram},
+        start_{histogram ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}} {}
+
+    ~ScopedLatency() {
+        if (histogram_) {
+            histogram_->record(std::chrono::steady_clock::now() - start_);
+        }
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram* histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
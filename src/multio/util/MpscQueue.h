@@ -0,0 +1,149 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace multio::util {
+
+/// Bounded lock-free queue for any number of producer threads and exactly one consumer thread.
+/// Each slot carries a sequence number telling whether it is free for the producer claiming that position or ready
+/// for the consumer. Producers wait on a full queue by backing off, the consumer sleeps on an empty one.
+template <class T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t capacity) : cells_(roundUpToPowerOfTwo(capacity)), mask_{cells_.size() - 1} {
+        ASSERT(capacity > 0);
+        for (std::size_t i = 0; i < cells_.size(); ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Any thread. Leaves item untouched and returns false if the queue is full.
+    bool tryPush(T& item) {
+        Cell* cell;
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const auto seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::move(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in pop: either the consumer sees the item or this sees the consumer waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting_.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            cv_.notify_one();
+        }
+        return true;
+    }
+
+    /// Any thread. Blocks while the queue is full.
+    void push(T&& item) {
+        unsigned rounds = 0;
+        while (!tryPush(item)) {
+            if (++rounds < yieldRounds) {
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+
+    /// Consumer only
+    std::optional<T> tryPop() {
+        Cell& cell = cells_[head_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(cell.value)};
+        cell.value.reset();
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return item;
+    }
+
+    /// Consumer only. Blocks while the queue is empty.
+    T pop() {
+        for (unsigned rounds = 0; rounds < yieldRounds; ++rounds) {
+            if (auto item = tryPop()) {
+                return std::move(*item);
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        consumerWaiting_.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::optional<T> item;
+        cv_.wait(lock, [&]() { return (item = tryPop()).has_value(); });
+        consumerWaiting_.store(false, std::memory_order_relaxed);
+        return std::move(*item);
+    }
+
+    std::size_t capacity() const { return cells_.size(); }
+
+private:
+    static constexpr unsigned yieldRounds = 64;
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::optional<T> value;
+    };
+
+    std::vector<Cell> cells_;
+    const std::size_t mask_;
+
+    // Producer claim position and consumer position on separate cache lines
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::size_t head_{0};
+
+    std::atomic<bool> consumerWaiting_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace multio::util
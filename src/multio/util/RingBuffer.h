@@ -65,7 +65,7 @@ public:
         do {
             const uint32_t prodTail = prodTail_.load(std::memory_order::memory_order_acquire);
 
-            consNext = consHead_ + 1;
+            consNext = consHead + 1;
             if ((prodTail - consHead) <= 0) {
                 return std::optional<T>();
             }
@@ -0,0 +1,82 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace multio::util {
+
+/// Bounded lock-free queue for exactly one producer and one consumer thread.
+/// Blocking on a full or empty queue is left to the caller.
+template <class T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) : slots_(roundUpToPowerOfTwo(capacity)), mask_{slots_.size() - 1} {
+        ASSERT(capacity > 0);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer only. Leaves item untouched and returns false if the queue is full.
+    bool tryPush(T& item) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        slots_[tail & mask_].emplace(std::move(item));
+        tail_.store(tail + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /// Consumer only
+    std::optional<T> tryPop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(slots_[head & mask_])};
+        slots_[head & mask_].reset();
+        head_.store(head + 1, std::memory_order_seq_cst);
+        return item;
+    }
+
+    bool empty() const { return head_.load(std::memory_order_seq_cst) == tail_.load(std::memory_order_seq_cst); }
+
+    bool full() const {
+        return tail_.load(std::memory_order_seq_cst) - head_.load(std::memory_order_seq_cst) == slots_.size();
+    }
+
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+    static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    std::vector<std::optional<T>> slots_;
+    const std::size_t mask_;
+
+    // Separate cache lines for consumer and producer position
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace multio::util
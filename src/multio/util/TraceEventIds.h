@@ -37,6 +37,14 @@ enum TraceEventIds : uint64_t
     MULTIO_SECOND_LEVEL_PAGE_TABLE_ENTRY_VIRTUAL_MEMORY = 0x0F00000000000000ULL,
     MULTIO_SWAPPED_OUT_VIRTUAL_MEMORY = 0x1000000000000000ULL,
     MULTIO_HUGE_TABLE_MEMORY = 0x1100000000000000ULL,
+
+    // Spans, see TraceSpan.h
+    MULTIO_SPAN_RECEIVE = 0x2000000000000000ULL,
+    MULTIO_SPAN_DECODE = 0x2100000000000000ULL,
+    MULTIO_SPAN_DISPATCH = 0x2200000000000000ULL,
+    MULTIO_SPAN_ACTION = 0x2300000000000000ULL,
+    MULTIO_SPAN_ENCODE = 0x2400000000000000ULL,
+    MULTIO_SPAN_SINK_WRITE = 0x2500000000000000ULL,
 };
 
 }
\ No newline at end of file
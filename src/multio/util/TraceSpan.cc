@@ -0,0 +1,92 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "multio/util/TraceSpan.h"
+
+#include <atomic>
+#include <string>
+
+#include "eckit/config/Resource.h"
+
+#include "multio/message/Glossary.h"
+#include "multio/message/Metadata.h"
+#include "multio/util/Hash.h"
+#include "multio/util/Tracer.h"
+#include "multio/util/VariantHelpers.h"
+
+namespace multio::util {
+
+namespace {
+
+constexpr std::uint64_t beginFlag = 1ULL << 48;
+constexpr int threadShift = 32;
+
+// Number of chunks and events per chunk, as used for memory profiling
+constexpr std::uint32_t numberOfChunks = 8;
+constexpr std::uint32_t eventsPerChunk = 32768;
+
+struct SpanTracer {
+    Tracer tracer{numberOfChunks, eventsPerChunk,
+                  eckit::Resource<std::string>("multioTraceFile;$MULTIO_TRACE_FILE", "./multio_trace.bin")};
+
+    SpanTracer() { tracer.startWriterThread(); }
+};
+
+void hashCombine(std::uint32_t& hash, const std::string& s) {
+    // Separated, so that e.g. the values "1", "23" and "12", "3" differ
+    const unsigned char separator = 0xFF;
+    hash = fnv1a(&separator, 1, fnv1a(s, hash));
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Tracer& spanTracer() {
+    static SpanTracer spanTracer;
+    return spanTracer.tracer;
+}
+
+std::uint16_t traceThreadIndex() {
+    static std::atomic<std::uint16_t> next{1};
+    thread_local const std::uint16_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+std::uint32_t traceFieldKey(const message::Metadata& md) {
+    const auto& g = message::glossary();
+
+    auto hash = Fnv1a<std::uint32_t>::basis;
+    for (const auto* key : {&g.param, &g.paramId, &g.level, &g.levelist, &g.levtype, &g.step}) {
+        if (auto it = md.find(*key); it != md.end()) {
+            if (auto value = visitTranslate<std::string>(it->second)) {
+                hashCombine(hash, *value);
+            }
+        }
+    }
+    return hash;
+}
+
+TraceSpan::TraceSpan(TraceEventIds id, std::uint32_t fieldKey) : TraceSpan{spanTracer(), id, fieldKey} {}
+
+TraceSpan::TraceSpan(Tracer& tracer, TraceEventIds id, std::uint32_t fieldKey) :
+    tracer_{tracer},
+    event_{static_cast<std::uint64_t>(id) | (static_cast<std::uint64_t>(traceThreadIndex()) << threadShift)
+           | fieldKey} {
+    tracer_.recordEvent(event_ | beginFlag);
+}
+
+TraceSpan::~TraceSpan() {
+    tracer_.recordEvent(event_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
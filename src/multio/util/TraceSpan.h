@@ -0,0 +1,79 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "multio/util/TraceEventIds.h"
+
+namespace multio::message {
+class Metadata;
+}
+
+namespace multio::util {
+
+class Tracer;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Spans of the processing pipeline, for a timeline of the run.
+ *
+ * Each span records a begin and an end event with the tracer returned by spanTracer(). An event is packed as:
+ *   bits 56-63  span id (TraceEventIds)
+ *   bit  48     1 for begin, 0 for end
+ *   bits 32-47  thread index within the process
+ *   bits  0-31  hash of the field key, 0 if there is no field
+ *
+ * The events are written to <multioTraceFile>_<rank> ($MULTIO_TRACE_FILE, default ./multio_trace.bin) and converted
+ * to the Chrome trace format by multio-convert-trace-log --chrome-trace.
+ *
+ * Spans are only recorded if multio is built with the TRACING feature, otherwise MULTIO_TRACE_SPAN expands to nothing
+ * and its arguments are not evaluated.
+ */
+Tracer& spanTracer();
+
+/// Small index of the calling thread, unique within the process
+std::uint16_t traceThreadIndex();
+
+/// Hash of the keys identifying a field (param, paramId, level, levelist, levtype, step)
+std::uint32_t traceFieldKey(const message::Metadata& md);
+
+class TraceSpan {
+public:
+    explicit TraceSpan(TraceEventIds id, std::uint32_t fieldKey = 0);
+
+    /// Records to the given tracer instead of spanTracer()
+    TraceSpan(Tracer& tracer, TraceEventIds id, std::uint32_t fieldKey = 0);
+
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    Tracer& tracer_;
+    std::uint64_t event_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::util
+
+#define MULTIO_TRACE_CONCAT_IMPL(a, b) a##b
+#define MULTIO_TRACE_CONCAT(a, b) MULTIO_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef MULTIO_TRACING_ENABLED
+#define MULTIO_TRACE_SPAN(...) \
+    const ::multio::util::TraceSpan MULTIO_TRACE_CONCAT(multioTraceSpan, __LINE__) { __VA_ARGS__ }
+#else
+#define MULTIO_TRACE_SPAN(...) static_cast<void>(0)
+#endif
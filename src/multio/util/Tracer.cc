@@ -19,6 +19,7 @@ Tracer::Tracer(uint32_t numChunks, uint32_t chunkSize, const std::string& output
     chunkSize_(chunkSize * 2),
     traceChunks_(numChunks, nullptr),
     currentChunkAndIndex_(0),
+    storedEntries_(new std::atomic_uint32_t[numChunks]),
     availableQueue_(numChunks),
     writeQueue_(numChunks),
     outputFile_(outputPath),
@@ -27,6 +28,7 @@ Tracer::Tracer(uint32_t numChunks, uint32_t chunkSize, const std::string& output
     for (auto i = 0; i < numChunks; ++i) {
         traceChunks_[i] = new uint64_t[chunkSize_];
         std::memset(traceChunks_[i], 0, chunkSize_ * sizeof(uint64_t));
+        storedEntries_[i].store(0, std::memory_order_relaxed);
         if (i > 0) {
             availableQueue_.push(i);
         }
@@ -34,14 +36,10 @@ Tracer::Tracer(uint32_t numChunks, uint32_t chunkSize, const std::string& output
 }
 
 Tracer::~Tracer() {
-    uint32_t chunkAndIndex = currentChunkAndIndex_.load(std::memory_order::memory_order_acquire);
-    uint32_t chunk = (chunkAndIndex & CHUNK_MASK) >> CHUNK_SHIFT;
-
-    writeQueue_.push(chunk);
+    const uint32_t chunkAndIndex = currentChunkAndIndex_.load(std::memory_order::memory_order_acquire);
 
-    // Removing this will cause the last chunk to be ocassionally lost.
-    // (race condition between write queue and running flag)
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // The writer thread drains the write queue after it has stopped running, so the last chunk is not lost
+    writeQueue_.push(chunkAndIndex);
 
     running_ = false;
 
@@ -91,7 +89,7 @@ void Tracer::recordEvent(uint64_t event) {
             // we wanted to change the chunk
             if (updated) {
                 // we changed the chunk, push the completed chunk to the write queue
-                writeQueue_.push(chunk);
+                writeQueue_.push(chunkAndIndex);
                 chunk = chunkNext;
                 index = 0;
             }
@@ -105,16 +103,16 @@ void Tracer::recordEvent(uint64_t event) {
 
     traceChunks_[chunk][index] = event;
     traceChunks_[chunk][index + 1] = timestamp;
+
+    // The chunk may already be queued for writing, the writer waits for this
+    storedEntries_[chunk].fetch_add(2, std::memory_order_release);
 }
 
 void Tracer::flushCurrentChunk() {
     bool updated = false;
-    uint32_t chunk = 0;
     uint32_t chunkAndIndex = currentChunkAndIndex_.load(std::memory_order::memory_order_acquire);
 
     do {
-        chunk = (chunkAndIndex & CHUNK_MASK) >> CHUNK_SHIFT;
-
         // get the next available chunk from the available queue
         auto availableChunkId = availableQueue_.pop();
         while (!availableChunkId) {
@@ -128,12 +126,12 @@ void Tracer::flushCurrentChunk() {
         // we wanted to change the chunk
         if (updated) {
             // we changed the chunk, push the completed chunk to the write queue
-            writeQueue_.push(chunk);
+            writeQueue_.push(chunkAndIndex);
         }
         else {
             // some other thread updated the chunk counters, most likely also changing the chunk,
             // so we put the available chunk we retrieved back in the available queue
-            availableQueue_.push(chunkNext);
+            availableQueue_.push(availableChunkId.value());
         }
     } while (!updated);
 }
@@ -146,26 +144,42 @@ void Tracer::writerThread_() {
 
     const auto traceFileHandle = open(oss.str().c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IWUSR | S_IRUSR);
 
-    while (running_.load(std::memory_order_acquire)) {
-        const auto finishedChunkId = writeQueue_.pop();
-        if (finishedChunkId) {
-            const auto id = finishedChunkId.value();
+    const auto writeChunk = [&](uint32_t chunkAndIndex) {
+        const uint32_t id = (chunkAndIndex & CHUNK_MASK) >> CHUNK_SHIFT;
 
-            const auto numBytesToWrite = chunkSize_ * sizeof(uint64_t);
-            const auto bytes = reinterpret_cast<const void*>(traceChunks_[id]);
+        // Threads which claimed entries before the chunk was switched may still be storing them
+        const uint32_t claimed = chunkAndIndex & INDEX_MASK;
+        while (storedEntries_[id].load(std::memory_order_acquire) != claimed) {
+            std::this_thread::yield();
+        }
+
+        const auto numBytesToWrite = chunkSize_ * sizeof(uint64_t);
+        const auto bytes = reinterpret_cast<const void*>(traceChunks_[id]);
 
-            write(traceFileHandle, bytes, numBytesToWrite);
-            fsync(traceFileHandle);
+        write(traceFileHandle, bytes, numBytesToWrite);
+        fsync(traceFileHandle);
 
-            std::memset(traceChunks_[id], 0, chunkSize_ * sizeof(uint64_t));
+        std::memset(traceChunks_[id], 0, chunkSize_ * sizeof(uint64_t));
+        storedEntries_[id].store(0, std::memory_order_relaxed);
 
-            availableQueue_.push(id);
+        availableQueue_.push(id);
+    };
+
+    while (running_.load(std::memory_order_acquire)) {
+        const auto finishedChunkId = writeQueue_.pop();
+        if (finishedChunkId) {
+            writeChunk(finishedChunkId.value());
         }
         else {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
 
+    // Chunks completed while stopping, including the last one pushed by the destructor
+    while (const auto finishedChunkId = writeQueue_.pop()) {
+        writeChunk(finishedChunkId.value());
+    }
+
     close(traceFileHandle);
 }
 
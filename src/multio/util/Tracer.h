@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -47,7 +48,10 @@ private:
     const uint32_t chunkSize_;
     std::vector<uint64_t*> traceChunks_;
     std::atomic_uint32_t currentChunkAndIndex_;
+    // Entries stored per chunk, the writer waits for all entries claimed before a chunk switch to be stored
+    std::unique_ptr<std::atomic_uint32_t[]> storedEntries_;
     RingBuffer<uint32_t> availableQueue_;
+    // Completed chunks with the number of entries claimed in them, packed like currentChunkAndIndex_
     RingBuffer<uint32_t> writeQueue_;
     std::string outputFile_;
     std::atomic_bool running_;
@@ -0,0 +1,161 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+/// Runs the registered microbenchmarks:
+///
+///   multio-benchmark [--filter=<substring>] [--min-time=<seconds>] [--json=<file>] [--baseline=<file>]
+///
+/// The JSON file lists name, iterations, time per operation and throughput of each benchmark, so that results of
+/// different commits can be compared. With --baseline, the change of the time per operation relative to a JSON file of
+/// an earlier run is printed as well.
+
+#include "Benchmark.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/JSON.h"
+#include "eckit/parser/YAMLParser.h"
+#include "eckit/runtime/Main.h"
+#include "eckit/utils/Translator.h"
+
+
+namespace multio::benchmark {
+
+Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+void Registry::add(const std::string& name, Function f) {
+    entries_.push_back(Entry{name, std::move(f)});
+}
+
+namespace {
+
+struct Options {
+    std::string filter;
+    double minTime = 0.2;
+    std::string json;
+    std::string baseline;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg{argv[i]};
+        auto value = [&arg](const std::string& option) -> std::optional<std::string> {
+            if (arg.rfind(option, 0) == 0) {
+                return arg.substr(option.size());
+            }
+            return std::nullopt;
+        };
+
+        if (auto v = value("--filter=")) {
+            options.filter = *v;
+        }
+        else if (auto v = value("--min-time=")) {
+            options.minTime = eckit::Translator<std::string, double>{}(*v);
+        }
+        else if (auto v = value("--json=")) {
+            options.json = *v;
+        }
+        else if (auto v = value("--baseline=")) {
+            options.baseline = *v;
+        }
+        else {
+            throw eckit::UserError("Unknown argument " + arg, Here());
+        }
+    }
+    return options;
+}
+
+// Time per operation of each benchmark in a JSON file written with --json
+std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    const auto json = eckit::YAMLParser::decodeFile(path);
+    for (const auto& b : json["benchmarks"].as<eckit::ValueList>()) {
+        baseline[b["name"].as<std::string>()] = b["ns_per_op"].as<double>();
+    }
+    return baseline;
+}
+
+}  // namespace
+
+}  // namespace multio::benchmark
+
+
+int main(int argc, char** argv) {
+    using namespace multio::benchmark;
+
+    eckit::Main::initialise(argc, argv);
+    const auto options = parseOptions(argc, argv);
+    const auto baseline = options.baseline.empty() ? std::map<std::string, double>{} : readBaseline(options.baseline);
+
+    const auto minTime
+        = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(options.minTime));
+
+    struct Result {
+        std::string name;
+        State state;
+    };
+    std::vector<Result> results;
+
+    for (const auto& entry : Registry::instance().entries()) {
+        if (entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        State state{minTime};
+        entry.function(state);
+
+        std::cout << std::left << std::setw(56) << entry.name << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(1) << state.nsPerOperation() << " ns/op" << std::setw(12) << state.iterations()
+                  << " iterations";
+        if (state.bytesPerOperation() > 0) {
+            std::cout << std::setw(10) << std::setprecision(2)
+                      << (state.bytesPerOperation() / state.nsPerOperation()) << " GB/s";
+        }
+        if (auto b = baseline.find(entry.name); b != baseline.end() && b->second > 0) {
+            std::cout << std::setw(10) << std::setprecision(1) << std::showpos
+                      << (100.0 * (state.nsPerOperation() / b->second - 1.0)) << std::noshowpos << "% vs baseline";
+        }
+        std::cout << std::endl;
+
+        results.push_back(Result{entry.name, state});
+    }
+
+    if (!options.json.empty()) {
+        std::ofstream out{options.json};
+        eckit::JSON json{out};
+        json.startObject();
+        json << "benchmarks";
+        json.startList();
+        for (const auto& r : results) {
+            json.startObject();
+            json << "name" << r.name;
+            json << "iterations" << r.state.iterations();
+            json << "ns_per_op" << r.state.nsPerOperation();
+            if (r.state.bytesPerOperation() > 0) {
+                json << "bytes_per_op" << r.state.bytesPerOperation();
+            }
+            json.endObject();
+        }
+        json.endList();
+        json.endObject();
+        out << std::endl;
+    }
+
+    return 0;
+}
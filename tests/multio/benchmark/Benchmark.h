@@ -0,0 +1,107 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace multio::benchmark {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Keeps the compiler from optimising away a value that is computed but never used
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class State {
+public:
+    explicit State(std::chrono::nanoseconds minTime) : minTime_{minTime} {}
+
+    /// Times the operation. The number of repetitions doubles until a batch takes at least the minimum time, the result
+    /// is the average time per operation of that batch. Setup done before calling this is not timed.
+    template <typename Operation>
+    void measure(Operation&& op) {
+        using Clock = std::chrono::steady_clock;
+        for (std::size_t n = 1;; n *= 2) {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < n; ++i) {
+                op();
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            if ((elapsed >= minTime_) || (n >= maxIterations)) {
+                iterations_ = n;
+                nsPerOperation_ = static_cast<double>(elapsed.count()) / static_cast<double>(n);
+                return;
+            }
+        }
+    }
+
+    /// Bytes processed by one operation, reported as throughput
+    void setBytesPerOperation(std::size_t bytes) { bytesPerOperation_ = bytes; }
+
+    std::size_t iterations() const { return iterations_; }
+    double nsPerOperation() const { return nsPerOperation_; }
+    std::size_t bytesPerOperation() const { return bytesPerOperation_; }
+
+private:
+    static constexpr std::size_t maxIterations = std::size_t{1} << 30;
+
+    std::chrono::nanoseconds minTime_;
+    std::size_t iterations_ = 0;
+    double nsPerOperation_ = 0;
+    std::size_t bytesPerOperation_ = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Registry {
+public:
+    using Function = std::function<void(State&)>;
+
+    struct Entry {
+        std::string name;
+        Function function;
+    };
+
+    static Registry& instance();
+
+    void add(const std::string& name, Function f);
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    std::vector<Entry> entries_;
+};
+
+struct Registration {
+    Registration(const std::string& name, Registry::Function f) { Registry::instance().add(name, std::move(f)); }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::benchmark
+
+
+#define MULTIO_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define MULTIO_BENCHMARK_CONCAT(a, b) MULTIO_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Defines and registers a benchmark: MULTIO_BENCHMARK("group/name") { ...; state.measure([&]() { ... }); }
+#define MULTIO_BENCHMARK(name)                                                                               \
+    static void MULTIO_BENCHMARK_CONCAT(benchmark_, __LINE__)(multio::benchmark::State&);                    \
+    static multio::benchmark::Registration MULTIO_BENCHMARK_CONCAT(registration_, __LINE__){                 \
+        name, MULTIO_BENCHMARK_CONCAT(benchmark_, __LINE__)};                                                \
+    static void MULTIO_BENCHMARK_CONCAT(benchmark_, __LINE__)([[maybe_unused]] multio::benchmark::State & state)
@@ -0,0 +1,107 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Fields.h"
+
+#include <algorithm>
+#include <string>
+
+#include "eckit/io/Buffer.h"
+
+#include "multio/message/Glossary.h"
+
+
+namespace multio::benchmark {
+
+using message::glossary;
+using message::Metadata;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Metadata ifsMetadata() {
+    const auto& g = glossary();
+    Metadata md;
+    md.set(g.category, "model-level");
+    md.set(g.name, "t");
+    md.set(g.param, 130);
+    md.set(g.paramId, 130);
+    md.set(g.level, 137);
+    md.set(g.levtype, "ml");
+    md.set(g.levelist, 137);
+    md.set(g.step, 24);
+    md.set(g.stepUnits, "h");
+    md.set(g.date, 20240101);
+    md.set(g.time, 0);
+    md.set(g.startDate, 20240101);
+    md.set(g.startTime, 0);
+    md.set(g.classKey, "od");
+    md.set(g.stream, "oper");
+    md.set(g.type, "fc");
+    md.set(g.expver, "0001");
+    md.set(g.gribEdition, "2");
+    md.set(g.tablesVersion, 32);
+    md.set(g.generatingProcessIdentifier, 155);
+    md.set(g.subCentre, 0);
+    md.set(g.gridType, "reduced_gg");
+    md.set(g.domain, "grid-point");
+    md.set(g.globalSize, 6599680);
+    md.set(g.precision, "double");
+    md.set(g.bitsPerValue, 16);
+    md.set(g.missingValue, 9999.0);
+    md.set(g.bitmapPresent, false);
+    md.set(g.timeStep, 450);
+    md.set(g.sampleInterval, 1);
+    md.set(g.typeOfLevel, "hybrid");
+    md.set(g.setPackingType, "grid_ccsds");
+    md.set(g.productionStatusOfProcessedData, 0);
+    md.set(g.typeOfGeneratingProcess, 2);
+    md.set("trigger", "step");
+    md.set("toAllServers", false);
+    md.set("misc-numberOfValues", 6599680);
+    md.set("misc-pl", "O1280");
+    md.set("encoder-overwrites", "none");
+    md.set("unitsFactor", 1.0);
+    return md;
+}
+
+Metadata nemoMetadata() {
+    const auto& g = glossary();
+    Metadata md;
+    md.set(g.category, "ocean-2d");
+    md.set(g.name, "sst");
+    md.set(g.nemoParam, "sst");
+    md.set(g.param, 262101);
+    md.set(g.paramId, 262101);
+    md.set(g.level, 0);
+    md.set(g.step, 24);
+    md.set(g.startDate, 20240101);
+    md.set(g.startTime, 0);
+    md.set(g.domain, "T grid");
+    md.set(g.globalSize, 1442 * 1021);
+    md.set(g.precision, "single");
+    md.set(g.gridType, "unstructured_grid");
+    md.set(g.unstructuredGridType, "ORCA025");
+    md.set(g.unstructuredGridSubtype, "T");
+    md.set("toAllServers", false);
+    return md;
+}
+
+message::Message makeField(Metadata md, std::size_t n) {
+    const auto width = (md.get<std::string>(glossary().precision) == "single") ? sizeof(float) : sizeof(double);
+    eckit::Buffer payload(n * width);
+    std::fill_n(static_cast<char*>(payload.data()), payload.size(), 0);
+    return message::Message{
+        message::Message::Header{message::Message::Tag::Field, message::Peer{}, message::Peer{}, std::move(md)},
+        std::move(payload)};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::benchmark
@@ -0,0 +1,36 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+/// Representative fields shared by the benchmarks
+
+#pragma once
+
+#include <cstddef>
+
+#include "multio/message/Message.h"
+#include "multio/message/Metadata.h"
+
+
+namespace multio::benchmark {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// Metadata of an IFS model level field as passed through the API (about 40 keys)
+message::Metadata ifsMetadata();
+
+/// Metadata of a NEMO ocean field as passed through the API (about 15 keys)
+message::Metadata nemoMetadata();
+
+/// Field message with the given metadata and a payload of n values of the precision given in the metadata
+message::Message makeField(message::Metadata md, std::size_t n);
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::benchmark
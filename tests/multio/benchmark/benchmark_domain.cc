@@ -0,0 +1,86 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+#include "Fields.h"
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "multio/domain/Domain.h"
+#include "multio/message/Glossary.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+using message::glossary;
+
+// ORCA025 grid decomposed into 4 x 4 partitions, the local data includes a halo of one point
+constexpr std::int32_t orcaNi = 1442;
+constexpr std::int32_t orcaNj = 1021;
+constexpr std::int32_t partNi = orcaNi / 4;
+constexpr std::int32_t partNj = orcaNj / 4;
+
+// O1280 grid decomposed into 64 contiguous partitions
+constexpr std::int64_t o1280Size = 6599680;
+constexpr std::int64_t o1280Parts = 64;
+
+void toGlobal(State& state, const domain::Domain& domain, const message::Message& local, std::size_t globalSize) {
+    auto global = makeField(local.metadata(), globalSize);
+    state.setBytesPerOperation(local.size());
+    state.measure([&]() {
+        domain.toGlobal(local, global);
+        doNotOptimize(global.payload().data());
+    });
+}
+
+void structured(State& state, const char* precision) {
+    // ni_global, nj_global, ibegin, ni, jbegin, nj, data_dim, data_ibegin, data_ni, data_jbegin, data_nj
+    std::vector<std::int32_t> definition{orcaNi, orcaNj, partNi, partNi, partNj, partNj, 2, -1, partNi + 2, -1,
+                                         partNj + 2};
+    const domain::Structured domain{std::move(definition)};
+
+    auto md = nemoMetadata();
+    md.set(glossary().precision, precision);
+    toGlobal(state, domain, makeField(std::move(md), (partNi + 2) * (partNj + 2)), orcaNi * orcaNj);
+}
+
+void unstructured(State& state, const char* precision) {
+    std::vector<std::int32_t> definition(o1280Size / o1280Parts);
+    std::iota(definition.begin(), definition.end(), static_cast<std::int32_t>(definition.size()));
+    const auto localSize = definition.size();
+    const domain::Unstructured domain{std::move(definition), o1280Size};
+
+    auto md = ifsMetadata();
+    md.set(glossary().precision, precision);
+    toGlobal(state, domain, makeField(std::move(md), localSize), o1280Size);
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("domain/to-global/structured/single") {
+    structured(state, "single");
+}
+
+MULTIO_BENCHMARK("domain/to-global/structured/double") {
+    structured(state, "double");
+}
+
+MULTIO_BENCHMARK("domain/to-global/unstructured/single") {
+    unstructured(state, "single");
+}
+
+MULTIO_BENCHMARK("domain/to-global/unstructured/double") {
+    unstructured(state, "double");
+}
+
+}  // namespace multio::benchmark
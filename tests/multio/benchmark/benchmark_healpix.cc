@@ -0,0 +1,67 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "multio/action/renumber-healpix/HEALPix.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+constexpr int nside = 1024;  // H1024, about 12.6 million points
+
+std::size_t hardwareThreads() {
+    const auto n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+void nestToRingMap(State& state, std::size_t threads) {
+    const HEALPix healpix{nside};
+    state.measure([&]() { doNotOptimize(healpix.nest_to_ring_map(threads)); });
+}
+
+void permute(State& state, std::size_t threads) {
+    const HEALPix healpix{nside};
+    const auto map = healpix.nest_to_ring_map(threads);
+    std::vector<double> in(map.size());
+    std::iota(in.begin(), in.end(), 0.0);
+    std::vector<double> out(map.size());
+
+    state.setBytesPerOperation(map.size() * sizeof(double));
+    state.measure([&]() {
+        healpix_permute(in.data(), out.data(), map, threads);
+        doNotOptimize(out.data());
+    });
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("healpix/nest-to-ring-map/1-thread") {
+    nestToRingMap(state, 1);
+}
+
+MULTIO_BENCHMARK("healpix/nest-to-ring-map/all-threads") {
+    nestToRingMap(state, hardwareThreads());
+}
+
+MULTIO_BENCHMARK("healpix/permute/1-thread") {
+    permute(state, 1);
+}
+
+MULTIO_BENCHMARK("healpix/permute/all-threads") {
+    permute(state, hardwareThreads());
+}
+
+}  // namespace multio::benchmark
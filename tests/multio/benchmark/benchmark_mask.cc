@@ -0,0 +1,98 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "eckit/io/Buffer.h"
+
+#include "multio/domain/MaskCompression.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+using domain::EncodedBitMaskPayload;
+using domain::EncodedRunLengthPayload;
+
+constexpr std::size_t maskSize = 1442 * 1021;  // ORCA025
+
+// Land-sea mask like pattern: alternating runs of 1 to 256 points, from a fixed linear congruential sequence
+std::vector<float> landSeaMask() {
+    std::vector<float> mask(maskSize);
+    std::uint32_t seed = 12345;
+    float value = 1.0f;
+    for (std::size_t i = 0; i < maskSize;) {
+        seed = seed * 1664525u + 1013904223u;
+        const std::size_t run = 1 + ((seed >> 16) & 0xff);
+        for (std::size_t j = 0; j < run && i < maskSize; ++j, ++i) {
+            mask[i] = value;
+        }
+        value = 1.0f - value;
+    }
+    return mask;
+}
+
+// Counts the set points, iterating point by point
+std::size_t countPoints(const eckit::Buffer& encoded) {
+    std::size_t count = 0;
+    for (bool v : EncodedBitMaskPayload{encoded}) {
+        count += v;
+    }
+    return count;
+}
+
+// Counts the set points, iterating run by run
+std::size_t countRuns(const eckit::Buffer& encoded) {
+    std::size_t count = 0;
+    for (const auto& run : EncodedRunLengthPayload{encoded}) {
+        count += run.first ? run.second : 0;
+    }
+    return count;
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("mask/encode/bitmask") {
+    const auto mask = landSeaMask();
+    state.setBytesPerOperation(maskSize * sizeof(float));
+    state.measure([&]() { doNotOptimize(domain::encodeMaskBitMask(mask.data(), mask.size())); });
+}
+
+MULTIO_BENCHMARK("mask/encode/run-length") {
+    const auto mask = landSeaMask();
+    state.setBytesPerOperation(maskSize * sizeof(float));
+    state.measure([&]() { doNotOptimize(domain::encodeMaskRunLength(mask.data(), mask.size())); });
+}
+
+MULTIO_BENCHMARK("mask/decode/bitmask") {
+    const auto mask = landSeaMask();
+    const auto encoded = domain::encodeMaskBitMask(mask.data(), mask.size());
+    state.setBytesPerOperation(encoded.size());
+    state.measure([&]() { doNotOptimize(countPoints(encoded)); });
+}
+
+MULTIO_BENCHMARK("mask/decode/run-length/points") {
+    const auto mask = landSeaMask();
+    const auto encoded = domain::encodeMaskRunLength(mask.data(), mask.size());
+    state.setBytesPerOperation(encoded.size());
+    state.measure([&]() { doNotOptimize(countPoints(encoded)); });
+}
+
+MULTIO_BENCHMARK("mask/decode/run-length/runs") {
+    const auto mask = landSeaMask();
+    const auto encoded = domain::encodeMaskRunLength(mask.data(), mask.size());
+    state.setBytesPerOperation(encoded.size());
+    state.measure([&]() { doNotOptimize(countRuns(encoded)); });
+}
+
+}  // namespace multio::benchmark
@@ -0,0 +1,114 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+#include "Fields.h"
+
+#include "multio/message/Glossary.h"
+#include "multio/message/Metadata.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+using message::glossary;
+using message::Metadata;
+
+void setAll(State& state, Metadata (*create)()) {
+    state.measure([&]() { doNotOptimize(create()); });
+}
+
+void copy(State& state, const Metadata& md) {
+    state.measure([&]() {
+        Metadata copied{md};
+        doNotOptimize(copied);
+    });
+}
+
+void findGlossaryKey(State& state, const Metadata& md) {
+    const auto& key = glossary().paramId;
+    state.measure([&]() { doNotOptimize(md.find(key)); });
+}
+
+void findStringKey(State& state, const Metadata& md) {
+    state.measure([&]() { doNotOptimize(md.find("toAllServers")); });
+}
+
+void findMissingKey(State& state, const Metadata& md) {
+    const Metadata::KeyType key{"notContained"};
+    state.measure([&]() { doNotOptimize(md.find(key)); });
+}
+
+void toString(State& state, const Metadata& md) {
+    state.measure([&]() { doNotOptimize(md.toString()); });
+}
+
+// Parses the string representation of the metadata, which is valid YAML
+void fromYAML(State& state, const Metadata& md) {
+    const auto yaml = md.toString();
+    state.setBytesPerOperation(yaml.size());
+    state.measure([&]() { doNotOptimize(message::metadataFromYAML(yaml)); });
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("metadata/set/ifs") {
+    setAll(state, ifsMetadata);
+}
+
+MULTIO_BENCHMARK("metadata/set/nemo") {
+    setAll(state, nemoMetadata);
+}
+
+MULTIO_BENCHMARK("metadata/copy/ifs") {
+    copy(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/copy/nemo") {
+    copy(state, nemoMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/find-glossary-key/ifs") {
+    findGlossaryKey(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/find-glossary-key/nemo") {
+    findGlossaryKey(state, nemoMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/find-string-key/ifs") {
+    findStringKey(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/find-string-key/nemo") {
+    findStringKey(state, nemoMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/find-missing-key/ifs") {
+    findMissingKey(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/to-string/ifs") {
+    toString(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/to-string/nemo") {
+    toString(state, nemoMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/from-yaml/ifs") {
+    fromYAML(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("metadata/from-yaml/nemo") {
+    fromYAML(state, nemoMetadata());
+}
+
+}  // namespace multio::benchmark
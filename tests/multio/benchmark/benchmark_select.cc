@@ -0,0 +1,55 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+#include "Fields.h"
+
+#include <sstream>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+
+#include "multio/message/MetadataMatcher.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+using message::Metadata;
+using message::match::MatchReduce;
+
+// Selector of a typical output plan: a few categories and a list of parameters, excluding some levels
+MatchReduce planSelector() {
+    std::stringstream yaml;
+    yaml << R"json(
+        {
+          "match" : { "category" : [ "model-level", "pressure-level", "surface" ],
+                      "paramId" : [ 129, 130, 131, 132, 133, 135, 138, 152, 155, 157, 246, 247, 248 ] },
+          "ignore" : { "level" : [ 1, 2, 3 ] }
+        })json";
+    return MatchReduce::construct(eckit::LocalConfiguration{eckit::YAMLConfiguration(yaml)});
+}
+
+void matches(State& state, const Metadata& md) {
+    const auto selector = planSelector();
+    state.measure([&]() { doNotOptimize(selector.matches(md)); });
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("select/matches/hit") {
+    matches(state, ifsMetadata());
+}
+
+MULTIO_BENCHMARK("select/matches/miss") {
+    matches(state, nemoMetadata());
+}
+
+}  // namespace multio::benchmark
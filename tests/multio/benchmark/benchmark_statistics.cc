@@ -0,0 +1,102 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+#include "Fields.h"
+
+#include <memory>
+#include <string>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/types/Date.h"
+#include "eckit/types/DateTime.h"
+#include "eckit/types/Time.h"
+
+#include "multio/action/statistics/OperationWindow.h"
+#include "multio/action/statistics/Operations.h"
+#include "multio/action/statistics/cfg/StatisticsConfiguration.h"
+#include "multio/action/statistics/cfg/StatisticsOptions.h"
+#include "multio/config/ComponentConfiguration.h"
+#include "multio/config/MultioConfiguration.h"
+#include "multio/message/Glossary.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+using message::glossary;
+
+constexpr std::size_t fieldSize = 1442 * 1021;  // ORCA025
+
+// Updates a statistics operation with one step of a field, within a daily window of hourly steps
+void update(State& state, const std::string& operation, bool withMissing) {
+    const config::MultioConfiguration multioConfig{eckit::LocalConfiguration{}};
+    const action::StatisticsOptions options{config::ComponentConfiguration{eckit::LocalConfiguration{}, multioConfig}};
+
+    auto md = nemoMetadata();
+    md.set(glossary().precision, "double");
+    md.set(glossary().missingValue, 9999.0);
+    md.set(glossary().bitmapPresent, withMissing);
+    auto field = makeField(std::move(md), fieldSize);
+    auto* values = static_cast<double*>(field.payload().modifyData());
+    for (std::size_t i = 0; i < fieldSize; ++i) {
+        values[i] = (withMissing && (i % 3 == 0)) ? 9999.0 : static_cast<double>(i % 100);
+    }
+
+    const action::StatisticsConfiguration cfg{field, options};
+
+    const eckit::DateTime start{eckit::Date{2024, 1, 1}, eckit::Time{0}};
+    action::OperationWindow window{start, start, start, start + eckit::Second{86400}, 3600, 0};
+    window.updateData(start + eckit::Second{3600});
+
+    std::shared_ptr<action::StatisticsIO> io;
+    auto op = action::make_operation<double>(operation, static_cast<long>(field.size()), io, window, cfg);
+
+    const auto* data = field.payload().data();
+    const auto size = static_cast<long>(field.size());
+    state.setBytesPerOperation(field.size());
+    state.measure([&]() { op->updateData(data, size, cfg); });
+}
+
+}  // namespace
+
+MULTIO_BENCHMARK("statistics/update/instant") {
+    update(state, "instant", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/average") {
+    update(state, "average", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/average/missing") {
+    update(state, "average", true);
+}
+
+MULTIO_BENCHMARK("statistics/update/flux-average") {
+    update(state, "flux-average", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/accumulate") {
+    update(state, "accumulate", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/minimum") {
+    update(state, "minimum", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/maximum") {
+    update(state, "maximum", false);
+}
+
+MULTIO_BENCHMARK("statistics/update/maximum/missing") {
+    update(state, "maximum", true);
+}
+
+}  // namespace multio::benchmark
@@ -0,0 +1,61 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include "Benchmark.h"
+#include "Fields.h"
+
+#include "multio/transport/MpiStream.h"
+
+namespace multio::benchmark {
+
+namespace {
+
+constexpr std::size_t poolBufferSize = 64 * 1024 * 1024;  // Default of MULTIO_MPI_BUFFER_SIZE
+
+// Encodes a message into a stream of a pool buffer, as StreamPool::getStream() hands out for buffered sends
+void encodeField(State& state, const message::Message& msg) {
+    transport::MpiBuffer buffer{poolBufferSize};
+    state.setBytesPerOperation(msg.size());
+    state.measure([&]() {
+        transport::MpiOutputStream stream{buffer};
+        msg.encode(stream);
+        doNotOptimize(stream.bytesWritten());
+    });
+}
+
+void encodeHeader(State& state, const message::Message& msg) {
+    transport::MpiBuffer buffer{poolBufferSize};
+    state.measure([&]() {
+        transport::MpiOutputStream stream{buffer};
+        msg.header().encode(stream);
+        doNotOptimize(stream.bytesWritten());
+    });
+}
+
+}  // namespace
+
+// One partition of an O1280 field on 64 client ranks, and of an ORCA025 field on 16 client ranks
+MULTIO_BENCHMARK("transport/encode-field/ifs") {
+    encodeField(state, makeField(ifsMetadata(), 6599680 / 64));
+}
+
+MULTIO_BENCHMARK("transport/encode-field/nemo") {
+    encodeField(state, makeField(nemoMetadata(), 1442 * 1021 / 16));
+}
+
+MULTIO_BENCHMARK("transport/encode-header/ifs") {
+    encodeHeader(state, makeField(ifsMetadata(), 0));
+}
+
+MULTIO_BENCHMARK("transport/encode-header/nemo") {
+    encodeHeader(state, makeField(nemoMetadata(), 0));
+}
+
+}  // namespace multio::benchmark
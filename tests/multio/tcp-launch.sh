@@ -1,9 +1,11 @@
 #!/bin/bash
 
 binary=${1:-multio-hammer}
+shift
+extra_args="$@"
 
 function fork_tcp_transport {
-    local cmd="$binary --transport=\"tcp\" --port=$@ --nbclients=5 --nbservers=3"
+    local cmd="$binary --transport=\"tcp\" --port=$@ --nbclients=5 --nbservers=3 $extra_args"
     eval $cmd
 }
 
@@ -0,0 +1,107 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/message/Message.h"
+#include "multio/server/AsyncDispatch.h"
+#include "multio/util/SpscQueue.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::Peer;
+
+namespace {
+Message makeMessage(std::int64_t step, std::size_t size = 8) {
+    return Message{Message::Header{Message::Tag::Field, Peer{}, Peer{}, Metadata{{{"step", step}}}},
+                   eckit::Buffer{size}};
+}
+}  // namespace
+
+CASE("Test SP/SC queue keeps order") {
+    multio::util::SpscQueue<std::uint32_t> queue(50);
+    EXPECT(queue.capacity() == 64);
+
+    auto t = std::thread([&queue]() {
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        auto item = queue.tryPop();
+        while (!item) {
+            item = queue.tryPop();
+        }
+        EXPECT(*item == i);
+    }
+
+    t.join();
+    EXPECT(queue.empty());
+}
+
+CASE("Test async dispatch processes in order and drains on flush") {
+    std::vector<std::int64_t> steps;
+    {
+        multio::server::AsyncDispatch dispatch(
+            [&steps](Message msg) { steps.push_back(msg.metadata().get<std::int64_t>("step")); }, 4, 16);
+
+        for (std::int64_t i = 0; i < 100; ++i) {
+            dispatch.push(makeMessage(i));
+        }
+        dispatch.drain();
+        EXPECT(steps.size() == 100);
+
+        dispatch.push(makeMessage(100, 1024));  // Exceeds the byte budget on its own
+    }
+    EXPECT(steps.size() == 101);
+    for (std::int64_t i = 0; i < 101; ++i) {
+        EXPECT(steps[i] == i);
+    }
+}
+
+CASE("Test async dispatch rethrows failures on the producer") {
+    multio::server::AsyncDispatch dispatch(
+        [](Message msg) {
+            if (msg.metadata().get<std::int64_t>("step") == 3) {
+                throw eckit::SeriousBug("Failing step 3");
+            }
+        },
+        8, 0);
+
+    // The failure is rethrown by the first push or drain after it happened, depending on the timing
+    EXPECT_THROWS_AS(
+        [&dispatch]() {
+            for (std::int64_t i = 0; i < 5; ++i) {
+                dispatch.push(makeMessage(i));
+            }
+            dispatch.drain();
+        }(),
+        eckit::SeriousBug);
+
+    // Failure is reported once, dispatching continues afterwards
+    EXPECT_NO_THROW(dispatch.push(makeMessage(5)));
+    EXPECT_NO_THROW(dispatch.drain());
+}
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
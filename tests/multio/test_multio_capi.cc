@@ -13,8 +13,13 @@
 
 #include <unistd.h>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <fstream>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "eckit/io/FileHandle.h"
 #include "eckit/testing/Test.h"
@@ -27,6 +32,8 @@
 #include "multio/config/PathConfiguration.h"
 #include "multio/util/Environment.h"
 
+#include "TestHelpers.h"
+
 using multio::config::configuration_file_name;
 using multio::config::configuration_path_name;
 
@@ -330,6 +337,137 @@ CASE("Test write field") {
     EXPECT(file_name.exists());
 }
 
+namespace {
+
+// Step containers of a single-field sink in a fresh directory, removed with the index on destruction
+class ContainerDir {
+    const eckit::PathName name_;
+
+    void remove() const {
+        for (const auto& file : {container(), index()}) {
+            if (file.exists()) {
+                file.unlink();
+            }
+        }
+        if (name_.exists()) {
+            name_.rmdir();
+        }
+    }
+
+public:
+    explicit ContainerDir(const eckit::PathName& name) : name_{name} {
+        remove();
+        name_.mkdir();
+    }
+    ~ContainerDir() { remove(); }
+
+    eckit::PathName name() const { return name_; }
+    eckit::PathName container() const { return name_ / "step::1"; }
+    eckit::PathName index() const { return name_ / "step::1.index"; }
+};
+
+// Writes the fields with varying levels through a single-field sink, as one batch or one call per field.
+// The handle is deleted on return, which closes the step container and writes its index.
+void writeLevels(const ContainerDir& dir, const std::vector<std::vector<double>>& fields,
+                 const std::vector<long long>& levels, bool batch) {
+    const TestFile plan{eckit::PathName{dir.name().asString() + ".yaml"}};
+    {
+        std::ofstream out{plan.name().asString()};
+        out << "plans:\n"
+            << "  - name: test-write-fields\n"
+            << "    actions:\n"
+            << "      - type: single-field-sink\n"
+            << "        root_path: \"" << dir.name().asString() << "/\"\n"
+            << "        step-containers: true\n";
+    }
+
+    multio_configuration_t* multio_cc = nullptr;
+    test_check(multio_new_configuration_from_filename(&multio_cc, plan.name().localPath()),
+               "Configuration Context Created From Filename");
+    std::unique_ptr<multio_configuration_t> configuration_deleter(multio_cc);
+
+    multio_handle_t* multio_handle = nullptr;
+    test_check(multio_new_handle(&multio_handle, multio_cc), "Create New handle");
+    EXPECT(multio_handle);
+    std::unique_ptr<multio_handle_t> handle_deleter(multio_handle);
+
+    multio_metadata_t* md = nullptr;
+    test_check(multio_new_metadata(&md, nullptr), "Create New Metadata Object");
+    std::unique_ptr<multio_metadata_t> multio_deleter(md);
+
+    const int size = static_cast<int>(fields.front().size());
+    test_check(multio_metadata_set_string(md, "param", "test"), "Set param");
+    test_check(multio_metadata_set_int(md, "globalSize", size), "Set globalsize");
+    test_check(multio_metadata_set_int(md, "step", 1), "Set step");
+
+    if (batch) {
+        std::vector<const double*> data;
+        for (const auto& field : fields) {
+            data.push_back(field.data());
+        }
+        const int nfields = static_cast<int>(fields.size());
+        test_check(multio_write_fields(multio_handle, md, "level", levels.data(), data.data(), size, nfields),
+                   "Write Fields");
+        return;
+    }
+
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        test_check(multio_metadata_set_int(md, "level", levels[i]), "Set level");
+        test_check(multio_write_field(multio_handle, md, fields[i].data(), size), "Write Field");
+    }
+}
+
+}  // namespace
+
+CASE("Test write fields batch") {
+    constexpr int size = 16;
+    const std::vector<long long> levels{3, 1, 2};
+
+    std::vector<std::vector<double>> fields;
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        fields.emplace_back(size);
+        for (int j = 0; j < size; ++j) {
+            fields.back()[j] = 100.0 * levels[i] + 0.5 * j;
+        }
+    }
+
+    auto path = util::getEnv("CMAKE_BINARY_HOME");
+    const eckit::PathName home{std::string{*path}};
+    const ContainerDir batchDir{home / "testWriteFieldsBatch"};
+    const ContainerDir singleDir{home / "testWriteFieldsSingle"};
+
+    writeLevels(batchDir, fields, levels, true);
+    writeLevels(singleDir, fields, levels, false);
+
+    // Every field is written with its own level and values, in the order of the batch
+    const auto container = file_content(batchDir.container());
+    std::istringstream index{file_content(batchDir.index())};
+
+    struct Entry {
+        std::string name;
+        std::int64_t offset;
+        std::int64_t length;
+    };
+    std::vector<Entry> entries;
+    for (Entry entry; index >> entry.name >> entry.offset >> entry.length;) {
+        entries.push_back(entry);
+    }
+
+    const std::size_t bytes = size * sizeof(double);
+    EXPECT(entries.size() == fields.size());
+    for (std::size_t i = 0; i < entries.size() && i < fields.size(); ++i) {
+        EXPECT_EQUAL(entries[i].name, std::to_string(levels[i]) + "::test::1");
+        EXPECT(entries[i].offset == static_cast<std::int64_t>(i * bytes));
+        EXPECT(entries[i].length == static_cast<std::int64_t>(bytes));
+        EXPECT(container.compare(i * bytes, bytes, reinterpret_cast<const char*>(fields[i].data()), bytes) == 0);
+    }
+    EXPECT(container.size() == fields.size() * bytes);
+
+    // The same output as one write per field
+    EXPECT(container == file_content(singleDir.container()));
+    EXPECT(file_content(batchDir.index()) == file_content(singleDir.index()));
+}
+
 }  // namespace multio::test
 
 int main(int argc, char** argv) {
@@ -0,0 +1,105 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/io/DataHandle.h"
+#include "eckit/testing/Test.h"
+
+#include "fdb5/api/FDB.h"
+#include "metkit/mars/MarsRequest.h"
+
+#include "multio/config/ComponentConfiguration.h"
+#include "multio/config/MultioConfiguration.h"
+#include "multio/message/Message.h"
+#include "multio/sink/DataSink.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::Peer;
+
+namespace {
+
+// Field identification in the multio test schema, with class under its MARS name
+Metadata fieldMetadata() {
+    return Metadata{{"marsClass", "od"}, {"expver", "0001"}, {"stream", "oper"}, {"date", 20240101},
+                    {"time", "0000"},    {"domain", "g"},    {"type", "fc"},     {"levtype", "sfc"},
+                    {"step", 6},         {"param", "167"}};
+}
+
+metkit::mars::MarsRequest fieldRequest() {
+    metkit::mars::MarsRequest request{"retrieve"};
+    request.setValue("class", "od");
+    request.setValue("expver", "0001");
+    request.setValue("stream", "oper");
+    request.setValue("date", "20240101");
+    request.setValue("time", "0000");
+    request.setValue("domain", "g");
+    request.setValue("type", "fc");
+    request.setValue("levtype", "sfc");
+    request.setValue("step", "6");
+    request.setValue("param", "167");
+    return request;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test asynchronous archiving by archive keys does not read the caller's buffer after write") {
+    const std::string expected(4096, 'a');
+
+    {
+        const eckit::LocalConfiguration config{eckit::YAMLConfiguration{std::string{R"json({
+            "type": "fdb5",
+            "async": true,
+            "archive-keys": ["class", "expver", "stream", "date", "time", "domain", "type", "levtype", "step",
+                             "param"]})json"}}};
+        config::MultioConfiguration multioConf{config};
+        std::unique_ptr<sink::DataSink> sink{
+            sink::DataSinkFactory::instance().build("fdb5", config::ComponentConfiguration{config, multioConf})};
+
+        // The message only references the buffer, which is overwritten and released as soon as write returns
+        auto buffer = std::make_unique<std::vector<char>>(expected.begin(), expected.end());
+        sink->write(Message{Message::Header{Message::Tag::Field, Peer{}, Peer{}, fieldMetadata()},
+                            message::PayloadReference{buffer->data(), buffer->size()}});
+        std::fill(buffer->begin(), buffer->end(), 'x');
+        buffer.reset();
+
+        sink->flush();
+        sink->sync();
+    }
+
+    fdb5::FDB fdb;
+    std::unique_ptr<eckit::DataHandle> handle{fdb.retrieve(fieldRequest())};
+
+    std::string archived(expected.size() + 1, '\0');
+    handle->openForRead();
+    {
+        eckit::AutoClose closer{*handle};
+        archived.resize(handle->read(archived.data(), archived.size()));
+    }
+    EXPECT(archived == expected);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -0,0 +1,169 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "multio/action/interpolate-fesom/FesomInterpolationCache.h"
+
+namespace multio::test {
+
+namespace {
+
+struct Matrix {
+    std::string key;
+    std::thread::id loadedBy;
+
+    size_t memoryFootprint() const { return 100; }
+};
+
+using Cache = action::interpolateFESOM::FesomInterpolationCache<Matrix>;
+
+// Counts the loads per key
+class Loads {
+public:
+    Cache::Loader loader() {
+        return [this](const std::string& key) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                ++counts_[key];
+            }
+            return std::make_unique<Matrix>(Matrix{key, std::this_thread::get_id()});
+        };
+    }
+
+    int count(const std::string& key) const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto search = counts_.find(key);
+        return search == counts_.end() ? 0 : search->second;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, int> counts_;
+};
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test cache evicts the least recently used entries at the memory bound") {
+    Loads loads;
+    Cache cache{loads.loader(), 250};
+
+    const auto a = cache.get("a");
+    cache.get("b");
+    EXPECT(cache.size() == 2);
+    EXPECT(cache.usedMemory() == 200);
+
+    // Over budget, "a" is the least recently used
+    cache.get("c");
+    EXPECT(cache.size() == 2);
+    EXPECT(cache.usedMemory() == 200);
+
+    // Evicted matrices stay valid while they are used
+    EXPECT(a->key == "a");
+
+    // A hit makes "b" the most recently used, so "c" goes next
+    cache.get("b");
+    cache.get("d");
+    cache.get("b");
+    EXPECT(loads.count("b") == 1);
+
+    cache.get("c");
+    cache.get("a");
+    EXPECT(loads.count("c") == 2);
+    EXPECT(loads.count("a") == 2);
+    EXPECT(loads.count("d") == 1);
+    EXPECT(cache.usedMemory() <= 250);
+}
+
+CASE("Test prefetched entries are hits") {
+    Loads loads;
+    std::atomic<int> loaded{0};
+    const auto loader = loads.loader();
+    Cache cache{[&](const std::string& key) {
+                    auto matrix = loader(key);
+                    ++loaded;
+                    return matrix;
+                },
+                0};
+
+    const std::vector<std::string> keys{"level_1", "level_2", "level_3"};
+    cache.prefetch(keys);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((loaded < 3) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT(loaded == 3);
+
+    for (const auto& key : keys) {
+        const auto matrix = cache.get(key);
+        EXPECT(matrix->key == key);
+        EXPECT(matrix->loadedBy != std::this_thread::get_id());
+        EXPECT(loads.count(key) == 1);
+    }
+    EXPECT(cache.size() == 3);
+    EXPECT(cache.usedMemory() == 300);
+}
+
+CASE("Test get waits for a key being prefetched instead of loading it again") {
+    Loads loads;
+    const auto loader = loads.loader();
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+
+    Cache cache{[&, gate](const std::string& key) {
+                    if (key == "slow") {
+                        started.set_value();
+                        gate.wait();
+                    }
+                    return loader(key);
+                },
+                0};
+
+    cache.prefetch({"slow"});
+    started.get_future().wait();
+
+    auto pending = std::async(std::launch::async, [&cache]() { return cache.get("slow"); });
+
+    // Other keys are not held up by the prefetch. Checked after the release, a failure must not block the prefetch.
+    const bool fastLoaded = cache.get("fast")->key == "fast";
+    const bool slowPending = pending.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout;
+
+    release.set_value();
+    EXPECT(fastLoaded);
+    EXPECT(slowPending);
+
+    const auto matrix = pending.get();
+    EXPECT(matrix->key == "slow");
+    EXPECT(matrix == cache.get("slow"));
+    EXPECT(loads.count("slow") == 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -10,11 +10,16 @@
 
 #include <unistd.h>
 #include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "eckit/filesystem/TmpFile.h"
+#include "eckit/log/Log.h"
 #include "eckit/message/Message.h"
 #include "eckit/testing/Test.h"
 
+#include "multio/message/Message.h"
 #include "multio/sink/FileSink.h"
 
 #include "TestDataContent.h"
@@ -108,6 +113,69 @@ CASE("FileSink appends to existing file") {
     EXPECT(file_content(file_path) == std::string{quote} + std::string{quote});
 }
 
+CASE("FileSink writes multio messages without conversion") {
+    const eckit::PathName& file_path = eckit::TmpFile();
+    const char quote[] = "All was quiet in the deep dark wood. The mouse found a nut and the nut was good.";
+
+    {
+        auto sink = make_configured_file_sink(file_path);
+        message::Message msg{{message::Message::Tag::Field, message::Peer{}, message::Peer{}, message::Metadata{}},
+                             message::SharedPayload{message::PayloadReference{quote, sizeof(quote) - 1}}};
+        sink->write(msg);
+    }
+
+    EXPECT(file_content(file_path) == std::string(quote));
+}
+
+CASE("FileSink writes and appends correctly with every file handle") {
+    const char quote[] = "All was quiet in the deep dark wood. The mouse found a nut and the nut was good.";
+
+    // Options selecting the file handle. Staged or queued data is only guaranteed to be in the file after flushing
+    const std::vector<std::pair<std::string, eckit::LocalConfiguration>> handles{
+        {"plain", eckit::LocalConfiguration{}},
+        {"staging buffer", eckit::LocalConfiguration{}.set("buffer-size", 4096)},
+#ifdef MULTIO_IO_URING_ENABLED
+        {"io_uring", eckit::LocalConfiguration{}.set("io-uring", true)},
+#endif
+    };
+
+    for (const auto& [name, options] : handles) {
+        eckit::Log::info() << "File handle: " << name << std::endl;
+
+        const eckit::PathName& file_path = eckit::TmpFile();
+        auto make_sink = [&file_path, &options = options](bool append) {
+            eckit::LocalConfiguration config{options};
+            config.set("path", file_path);
+            config.set("append", append);
+            config::MultioConfiguration multioConf(config);
+            config::ComponentConfiguration compConf(config, multioConf);
+            return DataSinkFactory::instance().build("file", compConf);
+        };
+
+        std::string expected;
+        {
+            auto sink = make_sink(false);
+            for (int i = 0; i < 200; ++i) {
+                eckit::message::Message msg{new TestDataContent{quote, sizeof(quote) - 1}};
+                sink->write(msg);
+                expected += quote;
+            }
+
+            sink->flush();
+            EXPECT(file_content(file_path) == expected);
+        }
+
+        {
+            auto sink = make_sink(true);
+            eckit::message::Message msg{new TestDataContent{quote, sizeof(quote) - 1}};
+            sink->write(msg);
+            expected += quote;
+        }
+
+        EXPECT(file_content(file_path) == expected);
+    }
+}
+
 }  // namespace multio::test
 
 int main(int argc, char** argv) {
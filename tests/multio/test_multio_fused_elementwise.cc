@@ -0,0 +1,162 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/action/Plan.h"
+#include "multio/config/MultioConfiguration.h"
+#include "multio/config/PathConfiguration.h"
+#include "multio/domain/Mappings.h"
+#include "multio/domain/Mask.h"
+#include "multio/domain/MaskCompression.h"
+#include "multio/message/Message.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::Peer;
+
+namespace {
+
+// Two full blocks of the fused action and a partial one
+constexpr std::int32_t ni = 50;
+constexpr std::int32_t nj = 45;
+constexpr std::int64_t size = ni * nj;
+
+const std::string stages = R"json(
+    {"type": "scale",
+     "mapping-definition": [{"case": {"param-is": "228", "map-to-param": "228228", "scaling-factor": 1000.0}}]},
+    {"type": "convert-precision", "precision": "single"},
+    {"type": "mask", "offset-fields": ["tp"], "offset-value": 0.5})json";
+
+// Valid runs of different lengths that cross the block boundaries
+bool isValid(std::int64_t i) {
+    return ((i / 300) % 2 == 0) && (i % 13 != 0);
+}
+
+double inputValue(std::int64_t i) {
+    return 1.0e-3 * static_cast<double>(i) + 1.0 / 3.0;
+}
+
+// Registers a structured domain covering the whole grid from a single client, and a mask for level 1 on it
+void registerMask() {
+    const Peer client{"client", 0};
+
+    const std::vector<std::int32_t> definition{ni, nj, 0, ni, 0, nj, 2, 0, ni, 0, nj};
+    domain::Mappings::instance().add(Message{
+        Message::Header{Message::Tag::Domain, client, Peer{},
+                        Metadata{{"name", "grid"}, {"representation", "structured"}, {"globalSize", size}}},
+        eckit::Buffer{definition.data(), definition.size() * sizeof(std::int32_t)}});
+
+    std::vector<bool> valid(size);
+    for (std::int64_t i = 0; i < size; ++i) {
+        valid[i] = isValid(i);
+    }
+    domain::Mask::instance().add(
+        Message{Message::Header{Message::Tag::Mask, client, Peer{},
+                                Metadata{{"name", "lsm"}, {"domain", "grid"}, {"level", 1}, {"globalSize", size}}},
+                domain::encodeMaskBitMask(valid, size)});
+}
+
+Message field() {
+    std::vector<double> values(size);
+    for (std::int64_t i = 0; i < size; ++i) {
+        values[i] = inputValue(i);
+    }
+
+    return Message{Message::Header{Message::Tag::Field, Peer{"client", 0}, Peer{},
+                                   Metadata{{"param", "228"},
+                                            {"name", "tp"},
+                                            {"domain", "grid"},
+                                            {"level", 1},
+                                            {"precision", "double"},
+                                            {"globalSize", size}}},
+                   eckit::Buffer{values.data(), values.size() * sizeof(double)}};
+}
+
+Message runPlan(const std::string& actions) {
+    const std::string plan = R"json({"name": "fused elementwise", "actions": [)json" + actions
+                           + R"json(, {"type": "debug-sink"}]})json";
+
+    config::ConfigAndPaths configAndPaths;
+    configAndPaths.paths = config::defaultConfigPaths();
+    configAndPaths.parsedConfig = eckit::LocalConfiguration{eckit::YAMLConfiguration(plan)};
+
+    config::MultioConfiguration multioConf{configAndPaths};
+    auto& debugSink = multioConf.debugSink();
+
+    action::Plan{config::ComponentConfiguration{multioConf.parsedConfig(), multioConf}}.process(field());
+
+    ASSERT(debugSink.size() == 1);
+    return debugSink.front();
+}
+
+std::string print(const message::MetadataValue& value) {
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test fused elementwise actions match the actions run one after the other") {
+    registerMask();
+
+    const auto sequential = runPlan(stages);
+    const auto fused = runPlan(R"json({"type": "fused-elementwise", "stages": [)json" + stages + "]}");
+
+    // Metadata as changed by all stages
+    EXPECT(fused.metadata().get<std::string>("param") == "228228");
+    EXPECT(fused.metadata().get<std::string>("precision") == "single");
+    EXPECT(fused.metadata().get<std::int64_t>("globalSize") == size);
+    EXPECT(fused.metadata().get<bool>("bitmapPresent"));
+
+    EXPECT(fused.metadata().size() == sequential.metadata().size());
+    for (const auto& [key, value] : sequential.metadata()) {
+        const auto it = fused.metadata().find(key);
+        EXPECT(it != fused.metadata().end());
+        if (it != fused.metadata().end()) {
+            EXPECT_EQUAL(print(it->second), print(value));
+        }
+    }
+
+    // Bit-identical values, with the missing value at masked points and the offset at valid ones
+    EXPECT(fused.precision() == util::PrecisionTag::Float);
+    EXPECT(fused.size() == size * sizeof(float));
+    EXPECT(sequential.size() == size * sizeof(float));
+    EXPECT(std::memcmp(fused.payload().data(), sequential.payload().data(), size * sizeof(float)) == 0);
+
+    const auto* values = static_cast<const float*>(fused.payload().data());
+    const auto missingValue = static_cast<float>(fused.metadata().get<double>("missingValue"));
+    for (const std::int64_t i : std::vector<std::int64_t>{0, 1, 600, 1023, 1024, 2047, 2048, size - 1}) {
+        const auto expected = isValid(i) ? static_cast<float>(inputValue(i) * 1000.0) + 0.5f : missingValue;
+        EXPECT(values[i] == expected);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
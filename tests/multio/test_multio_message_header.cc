@@ -0,0 +1,111 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "eckit/io/Buffer.h"
+#include "eckit/serialisation/MemoryStream.h"
+#include "eckit/serialisation/ResizableMemoryStream.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/message/Message.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::Peer;
+
+namespace {
+
+Message::Header roundTrip(const Message::Header& header) {
+    eckit::Buffer buffer{1024};
+    eckit::ResizableMemoryStream out{buffer};
+    header.encode(out);
+
+    // As the transports decode a received header
+    eckit::MemoryStream in{buffer.data(), static_cast<std::size_t>(out.position())};
+    return Message::Header::decode(in);
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test header round-trips through encode and decode") {
+    Message::Header header{Message::Tag::Field, Peer{"client", 3}, Peer{"server", 1},
+                           Metadata{{"param", "2t"}, {"step", 6}}};
+    header.setOrigin(Message::Origin{1700000000123456789, 42});
+
+    const auto decoded = roundTrip(header);
+
+    EXPECT(decoded.tag() == Message::Tag::Field);
+    EXPECT(decoded.source() == Peer("client", 3));
+    EXPECT(decoded.destination() == Peer("server", 1));
+    EXPECT(decoded.fieldId() == header.fieldId());
+    EXPECT(decoded.metadata().get<std::string>("param") == "2t");
+    EXPECT(decoded.metadata().get<std::int64_t>("step") == 6);
+
+    EXPECT(decoded.origin().time == 1700000000123456789);
+    EXPECT(decoded.origin().sequence == 42);
+}
+
+CASE("Test unstamped and fresh origins round-trip") {
+    Message::Header unstamped{Message::Tag::Flush, Peer{"client", 0}, Peer{"server", 0}};
+    EXPECT(roundTrip(unstamped).origin().time == 0);
+    EXPECT(roundTrip(unstamped).origin().sequence == 0);
+
+    const auto first = Message::Origin::now();
+    const auto second = Message::Origin::now();
+    EXPECT(second.sequence > first.sequence);
+    EXPECT(second.time >= first.time);
+
+    Message::Header stamped{Message::Tag::Field, Peer{"client", 0}, Peer{"server", 0}};
+    stamped.setOrigin(second);
+    const auto decoded = roundTrip(stamped);
+    EXPECT(decoded.origin().time == second.time);
+    EXPECT(decoded.origin().sequence == second.sequence);
+}
+
+CASE("Test message encoding keeps the origin and payload") {
+    const double values[] = {1.0, 2.0, 3.0};
+    Message msg{Message::Header{Message::Tag::Field, Peer{"client", 1}, Peer{"server", 2}, Metadata{{"step", 12}}},
+                eckit::Buffer{values, sizeof(values)}};
+    const auto origin = Message::Origin::now();
+    msg.header().setOrigin(origin);
+
+    eckit::Buffer buffer{1024};
+    eckit::ResizableMemoryStream out{buffer};
+    msg.encode(out);
+
+    // Same layout as decodeMessage of the MPI transport
+    eckit::MemoryStream in{buffer.data(), static_cast<std::size_t>(out.position())};
+    auto header = Message::Header::decode(in);
+    unsigned long size;
+    in >> size;
+    eckit::Buffer payload(size);
+    in >> payload;
+    Message decoded{std::move(header), std::move(payload)};
+
+    EXPECT(decoded.origin().time == origin.time);
+    EXPECT(decoded.origin().sequence == origin.sequence);
+    EXPECT(decoded.size() == sizeof(values));
+    EXPECT(std::memcmp(decoded.payload().data(), values, sizeof(values)) == 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -442,6 +442,38 @@ CASE("Test visit with unwrapped unique ptr") {
 }
 
 
+CASE("Test erasing and merging keys beyond the direct index") {
+    Metadata m;
+    for (std::int64_t i = 0; i < 600; ++i) {
+        m.set("key" + std::to_string(i), i);
+    }
+    EXPECT_EQUAL(m.size(), 600);
+
+    for (std::int64_t i = 0; i < 600; i += 3) {
+        EXPECT_EQUAL(m.erase("key" + std::to_string(i)), 1);
+    }
+    EXPECT_EQUAL(m.size(), 400);
+
+    for (std::int64_t i = 0; i < 600; ++i) {
+        auto search = m.find("key" + std::to_string(i));
+        if (i % 3 == 0) {
+            EXPECT(search == m.end());
+        }
+        else {
+            EXPECT(search != m.end());
+            EXPECT_EQUAL(search->second.get<std::int64_t>(), i);
+        }
+    }
+
+    Metadata other{{"key0", "zero"}, {"key1", "one"}};
+    m.merge(other);
+    EXPECT_EQUAL(m.get<std::string>("key0"), "zero");
+    EXPECT_EQUAL(m.get<std::int64_t>("key1"), 1);
+    EXPECT_EQUAL(other.size(), 1);
+    EXPECT_EQUAL(other.get<std::string>("key1"), "one");
+}
+
+
 }  // namespace multio::test
 
 int main(int argc, char** argv) {
@@ -78,6 +78,86 @@ CASE("Test update parametrization") {
 };
 
 
+CASE("Test parametrization snapshots") {
+    Parametrization::instance().clear();
+    Parametrization::instance().update(Metadata{{"a", 1}});
+
+    // A snapshot is not modified by later updates
+    const BaseMetadata& before = Parametrization::instance().get();
+    Parametrization::instance().update(Metadata{{"b", 2}});
+    EXPECT(before.find("b") == before.end());
+    EXPECT(Parametrization::instance().get().get<std::int64_t>("b") == 2);
+
+    // An inconsistent update is not applied partially
+    EXPECT_THROWS_AS(Parametrization::instance().update(Metadata{{"c", 3}, {"a", 2}}), MetadataException);
+    const BaseMetadata& after = Parametrization::instance().get();
+    EXPECT(after.find("c") == after.end());
+    EXPECT(after.get<std::int64_t>("a") == 1);
+
+    // Published values never move, neither with repeated nor with new keys
+    const auto* a = &(*Parametrization::instance().find("a"))->second;
+    for (int i = 0; i < 100; ++i) {
+        Parametrization::instance().update(Metadata{{"a", 1}, {"b", 2}});
+        Parametrization::instance().update(Metadata{{"d" + std::to_string(i), i}});
+    }
+    EXPECT(&(*Parametrization::instance().find("a"))->second == a);
+    EXPECT(Parametrization::instance().get().size() == 102);
+
+    // Values dropped by clear stay valid for metadata still referring to them
+    Parametrization::instance().clear();
+    EXPECT(!Parametrization::instance().find("a"));
+    EXPECT(a->get<std::int64_t>() == 1);
+};
+
+
+CASE("Test const parametrized lookups do not invalidate references") {
+    Parametrization::instance().clear();
+    Parametrization::instance().update(Metadata{{"level", 10}});
+
+    Metadata m{{"typeOfLevel", "isobaricInhPa"}};
+    const auto& typeOfLevel = m.get<std::string>("typeOfLevel");
+    const auto* address = &typeOfLevel;
+
+    const Metadata& cm = m;
+    EXPECT(cm.get<std::int64_t>("level") == 10);
+    EXPECT(m.size() == 1);
+    EXPECT(&m.get<std::string>("typeOfLevel") == address);
+    EXPECT(typeOfLevel == "isobaricInhPa");
+
+    // A local value shadows the parametrized one
+    m.set("level", 20);
+    EXPECT(m.get<std::int64_t>("level") == 20);
+    EXPECT(Parametrization::instance().get().get<std::int64_t>("level") == 10);
+};
+
+
+CASE("Test writing through parametrized lookups does not modify the parametrization") {
+    Parametrization::instance().clear();
+    Parametrization::instance().update(Metadata{{"level", 10}, {"levtype", "pl"}, {"step", 6}});
+
+    // Non-const lookups copy the parametrized value, writes only change this metadata
+    Metadata m;
+    m.get<std::int64_t>("level") = 20;
+    m.find("levtype")->second = MetadataValue{std::string{"sfc"}};
+    EXPECT(m.size() == 2);
+    EXPECT(m.get<std::int64_t>("level") == 20);
+    EXPECT(m.get<std::string>("levtype") == "sfc");
+
+    // Moving out of an rvalue leaves the parametrized value in place
+    EXPECT(std::string{Metadata{}.get<std::string>("levtype")} == "pl");
+    EXPECT(Metadata{}.getOpt<std::string>("levtype") == std::optional<std::string>{"pl"});
+
+    const auto& par = Parametrization::instance().get();
+    EXPECT(par.get<std::int64_t>("level") == 10);
+    EXPECT(par.get<std::string>("levtype") == "pl");
+    EXPECT(par.get<std::int64_t>("step") == 6);
+
+    const Metadata other;
+    EXPECT(other.get<std::int64_t>("level") == 10);
+    EXPECT(other.get<std::string>("levtype") == "pl");
+};
+
+
 }  // namespace multio::test
 
 int main(int argc, char** argv) {
@@ -0,0 +1,85 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "eckit/testing/Test.h"
+
+#include "multio/util/Metrics.h"
+
+namespace multio::test {
+
+using util::LatencyHistogram;
+
+CASE("Histogram buckets are contiguous and resolve values within 12.5%") {
+    EXPECT(LatencyHistogram::index(0) == 0);
+    EXPECT(LatencyHistogram::index(7) == 7);
+    EXPECT(LatencyHistogram::index(8) == 8);
+    EXPECT(LatencyHistogram::index(15) == 15);
+    EXPECT(LatencyHistogram::index(16) == 16);
+    EXPECT(LatencyHistogram::index(UINT64_MAX) == LatencyHistogram::size - 1);
+
+    for (std::uint64_t ns : {1ull, 9ull, 1000ull, 123456ull, 987654321ull, 3600000000000ull}) {
+        const auto i = LatencyHistogram::index(ns);
+        const auto upper = LatencyHistogram::upperBound(i) * 1e9;
+        EXPECT(static_cast<double>(ns) < upper);
+        EXPECT(upper <= static_cast<double>(ns) * 1.125 + 1);
+        if (i > 0) {
+            EXPECT(static_cast<double>(ns) + 0.5 > LatencyHistogram::upperBound(i - 1) * 1e9);
+        }
+    }
+}
+
+CASE("Histogram quantiles") {
+    LatencyHistogram h;
+    EXPECT(h.quantile(0.5) == 0.0);
+
+    for (int i = 1; i <= 99; ++i) {
+        h.record(std::chrono::microseconds(10));
+    }
+    h.record(std::chrono::milliseconds(10));
+
+    EXPECT(h.count() == 100);
+    EXPECT(h.quantile(0.5) > 10e-6);
+    EXPECT(h.quantile(0.5) < 12e-6);
+    EXPECT(h.quantile(0.99) < 12e-6);
+    EXPECT(h.quantile(1.0) > 10e-3);
+    EXPECT(h.quantile(1.0) < 12e-3);
+}
+
+CASE("Metrics are written in the OpenMetrics text format") {
+    auto& metrics = util::Metrics::instance();
+    const auto labels = util::metricsLabel("plan", "test \"plan\"");
+
+    metrics.histogram("multio_test_latency_seconds", labels, "Test latency").record(std::chrono::microseconds(10));
+    metrics.counter("multio_test_messages", labels, "Test messages").add(3);
+    metrics.gauge("multio_test_depth", "", "Test depth").set(5);
+
+    std::ostringstream out;
+    metrics.write(out);
+    const auto text = out.str();
+
+    EXPECT(labels == R"(plan="test \"plan\"")");
+    EXPECT(text.find("# TYPE multio_test_latency_seconds histogram\n") != std::string::npos);
+    EXPECT(text.find(R"(multio_test_latency_seconds_bucket{plan="test \"plan\"",le="+Inf"} 1)") != std::string::npos);
+    EXPECT(text.find(R"(multio_test_latency_seconds_count{plan="test \"plan\""} 1)") != std::string::npos);
+    EXPECT(text.find(R"(multio_test_messages_total{plan="test \"plan\""} 3)") != std::string::npos);
+    EXPECT(text.find("multio_test_depth 5\n") != std::string::npos);
+    EXPECT(text.rfind("# EOF\n") == text.size() - 6);
+}
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
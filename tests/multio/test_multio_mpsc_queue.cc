@@ -0,0 +1,72 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "multio/util/MpscQueue.h"
+
+namespace multio::test {
+
+CASE("Test capacity is rounded up to a power of two") {
+    multio::util::MpscQueue<std::uint32_t> queue(50);
+    EXPECT(queue.capacity() == 64);
+
+    std::uint32_t item = 0;
+    for (; item < 64; ++item) {
+        EXPECT(queue.tryPush(item));
+    }
+    EXPECT(!queue.tryPush(item));
+
+    EXPECT(queue.tryPop().value() == 0);
+    EXPECT(queue.tryPush(item));
+}
+
+CASE("Test MP/SC keeps the order of each producer") {
+    multio::util::MpscQueue<std::vector<std::uint32_t>> queue(8);
+
+    const std::uint32_t producers = 4;
+    const std::uint32_t count = 1000;
+
+    std::vector<std::thread> threads;
+    for (std::uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, count]() {
+            for (std::uint32_t i = 0; i < count; ++i) {
+                queue.push(std::vector<std::uint32_t>{p, i});
+            }
+        });
+    }
+
+    std::vector<std::uint32_t> received(producers, 0);
+    for (std::uint32_t i = 0; i < producers * count; ++i) {
+        auto item = queue.pop();
+        EXPECT(item.size() == 2);
+        EXPECT(item[1] == received[item[0]]);
+        ++received[item[0]];
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT(!queue.tryPop());
+    for (auto r : received) {
+        EXPECT(r == count);
+    }
+}
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -8,6 +8,7 @@
  * does it submit to any jurisdiction.
  */
 
+#include <atomic>
 #include <fstream>
 
 #include "eckit/config/YAMLConfiguration.h"
@@ -94,6 +95,27 @@ bool trigger_executed_correctly(const eckit::PathName& file, const std::vector<i
     return (expected == actual);
 }
 
+// Flushes in the background like an asynchronous FDB5Sink, flushed data is visible once synced
+class BackgroundFlushSink final : public DataSink {
+public:
+    explicit BackgroundFlushSink(const ComponentConfiguration& compConf) : DataSink(compConf) {}
+
+    void write(eckit::message::Message) override {}
+    void flush() override { ++flushed; }
+    void sync() override { visible = flushed.load(); }
+
+    static std::atomic<int> flushed;
+    static std::atomic<int> visible;
+
+private:
+    void print(std::ostream& os) const override { os << "BackgroundFlushSink()"; }
+};
+
+std::atomic<int> BackgroundFlushSink::flushed{0};
+std::atomic<int> BackgroundFlushSink::visible{0};
+
+DataSinkBuilder<BackgroundFlushSink> backgroundFlushSinkBuilder("test-background-flush");
+
 }  // namespace
 
 //-----------------------------------------------------------------------------
@@ -167,6 +189,74 @@ CASE("test_multio_with_event_trigger") {
     }
 }
 
+CASE("test_multio_async_sinks_keep_order") {
+    ::unsetenv("MULTIO_CONFIG_TRIGGERS");
+
+    TestFile file1{eckit::TmpFile().baseName()};
+    TestFile file2{eckit::TmpFile().baseName()};
+
+    std::string sinks(R"json({
+                  "async" : true,
+                  "queue-size" : 4,
+                  "sinks" : [
+                    { "type" : "file", "path" : ")json"
+                      + file1.name() + R"json(" },
+                    { "type" : "file", "path" : ")json"
+                      + file2.name() + R"json(" }
+                  ]
+                }
+                )json");
+
+    eckit::LocalConfiguration config{eckit::YAMLConfiguration(sinks)};
+    config::MultioConfiguration multioConf(config);
+    ComponentConfiguration compConf(config, multioConf);
+
+    // TestDataContent does not own the data, which must outlive the queued writes
+    std::vector<std::string> data;
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        data.push_back("message " + std::to_string(i) + "\n");
+        expected += data.back();
+    }
+
+    {
+        MultIO mio{compConf};
+        for (const auto& d : data) {
+            mio.write(eckit::message::Message{new TestDataContent{d.c_str(), d.length()}});
+        }
+
+        // Flushing waits until both sinks have written everything
+        mio.flush();
+        EXPECT(file_content(file1.name()) == expected);
+        EXPECT(file_content(file2.name()) == expected);
+    }
+}
+
+CASE("test_multio_trigger_waits_for_background_flushes") {
+    ::unsetenv("MULTIO_CONFIG_TRIGGERS");
+
+    std::string sinks(R"json({
+                  "async" : true,
+                  "sinks" : [ { "type" : "test-background-flush" } ]
+                }
+                )json");
+
+    eckit::LocalConfiguration config{eckit::YAMLConfiguration(sinks)};
+    config::MultioConfiguration multioConf(config);
+    ComponentConfiguration compConf(config, multioConf);
+
+    MultIO mio{compConf};
+
+    // Flushing only starts the background flush
+    mio.flush();
+    EXPECT(BackgroundFlushSink::flushed == 1);
+    EXPECT(BackgroundFlushSink::visible == 0);
+
+    // Notifications announce visible data
+    mio.trigger(eckit::StringDict{{"step", "6"}});
+    EXPECT(BackgroundFlushSink::visible == 1);
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
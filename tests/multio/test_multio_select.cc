@@ -518,6 +518,55 @@ CASE("Test enfore same key type") {
     }
 }
 
+CASE("Test required values used for plan indexing") {
+    {
+        std::stringstream confString;
+        confString << R"json(
+              {
+                "any" : [
+                      { "match": { "name": [ "a", "b" ], "level": 1 } },
+                      { "match": { "name": "c" } }
+                    ]
+            })json";
+
+        message::match::MatchReduce sel{eckit::LocalConfiguration{eckit::YAMLConfiguration(confString)}};
+
+        std::set<message::match::MatchKeys::KeyType> keys;
+        sel.constrainedKeys(keys);
+        EXPECT_EQUAL(keys.size(), 2);
+
+        auto names = sel.requiredValues("name");
+        EXPECT(names.has_value());
+        EXPECT_EQUAL(names->size(), 3);
+        EXPECT(names->find(message::MetadataValue{"c"}) != names->end());
+
+        // Second alternative does not constrain the level
+        EXPECT(!sel.requiredValues("level").has_value());
+        EXPECT(!sel.requiredValues("param").has_value());
+    }
+    {
+        std::stringstream confString;
+        confString << R"json(
+              {
+                "all" : [
+                      { "match": { "name": [ "a", "b" ] } },
+                      { "match": { "name": [ "b", "c" ] } },
+                      { "ignore": { "level": 1 } }
+                    ]
+            })json";
+
+        message::match::MatchReduce sel{eckit::LocalConfiguration{eckit::YAMLConfiguration(confString)}};
+
+        auto names = sel.requiredValues("name");
+        EXPECT(names.has_value());
+        EXPECT_EQUAL(names->size(), 1);
+        EXPECT(names->find(message::MetadataValue{"b"}) != names->end());
+
+        // Negated matchers never constrain
+        EXPECT(!sel.requiredValues("level").has_value());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
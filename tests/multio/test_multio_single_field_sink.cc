@@ -0,0 +1,177 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/action/Plan.h"
+#include "multio/config/MultioConfiguration.h"
+#include "multio/config/PathConfiguration.h"
+#include "multio/message/Message.h"
+#include "multio/util/Hash.h"
+
+#include "TestHelpers.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::Peer;
+
+namespace {
+
+// Output directory of one test case, removed with everything in it
+class TestDir {
+    const eckit::PathName name_;
+
+    void remove() const {
+        if (!name_.exists()) {
+            return;
+        }
+        std::vector<eckit::PathName> files;
+        std::vector<eckit::PathName> dirs;
+        name_.children(files, dirs);
+        for (const auto& file : files) {
+            file.unlink();
+        }
+        std::sort(dirs.rbegin(), dirs.rend());
+        for (const auto& dir : dirs) {
+            dir.rmdir();
+        }
+        name_.rmdir();
+    }
+
+public:
+    explicit TestDir(const std::string& name) : name_{name} {
+        remove();
+        name_.mkdir();
+    }
+    ~TestDir() { remove(); }
+    std::string path() const { return name_.asString() + "/"; }
+};
+
+// Runs the single-field sink with the given options, the plan is destroyed (and all files closed) on return
+void runSink(const std::string& options, const std::vector<Message>& messages) {
+    const std::string actions = R"json({"name": "single-field-sink", "actions": [{"type": "single-field-sink", )json"
+                              + options + "}]}";
+
+    config::ConfigAndPaths configAndPaths;
+    configAndPaths.paths = config::defaultConfigPaths();
+    configAndPaths.parsedConfig = eckit::LocalConfiguration{eckit::YAMLConfiguration(actions)};
+
+    config::MultioConfiguration multioConf{configAndPaths};
+    action::Plan plan{config::ComponentConfiguration{multioConf.parsedConfig(), multioConf}};
+
+    for (const auto& msg : messages) {
+        plan.process(msg);
+    }
+}
+
+Message field(const std::string& param, std::int64_t step, std::int64_t level, const std::string& data) {
+    return Message{Message::Header{Message::Tag::Field, Peer{}, Peer{},
+                                   Metadata{{"param", param}, {"step", step}, {"level", level}}},
+                   eckit::Buffer{data.data(), data.size()}};
+}
+
+Message flush() {
+    return Message{Message::Header{Message::Tag::Flush, Peer{}, Peer{}}};
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test files closed by max-open-files are reopened for appending") {
+    const TestDir dir{"single-field-sink-lru"};
+
+    std::vector<Message> messages;
+    for (const auto& round : {"first", "second"}) {
+        for (std::int64_t level = 1; level <= 5; ++level) {
+            messages.push_back(field("2t", 6, level, round + std::to_string(level)));
+        }
+    }
+    messages.push_back(flush());
+
+    runSink(R"("root_path": ")" + dir.path() + R"(", "max-open-files": 2)", messages);
+
+    for (std::int64_t level = 1; level <= 5; ++level) {
+        const auto lev = std::to_string(level);
+        EXPECT_EQUAL(file_content(dir.path() + lev + "::2t::6"), "first" + lev + "second" + lev);
+    }
+}
+
+CASE("Test directory shards place files by the FNV-1a hash of their name") {
+    const TestDir dir{"single-field-sink-shards"};
+    const std::uint32_t shards = 4;
+
+    std::vector<Message> messages;
+    for (std::int64_t level = 1; level <= 8; ++level) {
+        messages.push_back(field("msl", 12, level, "level" + std::to_string(level)));
+    }
+
+    runSink(R"("root_path": ")" + dir.path() + R"(", "directory-shards": )" + std::to_string(shards), messages);
+
+    for (std::int64_t level = 1; level <= 8; ++level) {
+        const auto name = std::to_string(level) + "::msl::12";
+        const eckit::PathName file{dir.path() + std::to_string(util::fnv1a(name) % shards) + "/" + name};
+        EXPECT(file.exists());
+        EXPECT_EQUAL(file_content(file), "level" + std::to_string(level));
+        EXPECT(!eckit::PathName{dir.path() + name}.exists());
+    }
+}
+
+CASE("Test step containers index every field by offset and length") {
+    const TestDir dir{"single-field-sink-containers"};
+
+    // Written before and after the flush, the index lines of the second batch are appended in the destructor
+    const std::map<std::string, std::string> step6{{"1::2t::6", "a"}, {"2::2t::6", "bbb"}, {"1::msl::6", "cc"}};
+    std::vector<Message> messages{field("2t", 6, 1, "a"), field("2t", 6, 2, "bbb"), field("msl", 12, 1, "dddd"),
+                                  flush(), field("msl", 6, 1, "cc")};
+
+    runSink(R"("root_path": ")" + dir.path() + R"(", "step-containers": true)", messages);
+
+    const auto check = [&dir](const std::string& step, const std::map<std::string, std::string>& expected) {
+        const auto container = file_content(dir.path() + "step::" + step);
+        std::istringstream index{file_content(dir.path() + "step::" + step + ".index")};
+
+        std::map<std::string, std::string> fields;
+        std::int64_t end = 0;
+        std::string name;
+        std::int64_t offset;
+        std::int64_t length;
+        while (index >> name >> offset >> length) {
+            // Fields are laid out back to back in the order they are written
+            EXPECT(offset == end);
+            end = offset + length;
+            fields[name] = container.substr(offset, length);
+        }
+        EXPECT(end == static_cast<std::int64_t>(container.size()));
+        EXPECT(fields == expected);
+    };
+
+    check("6", step6);
+    check("12", {{"1::msl::12", "dddd"}});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
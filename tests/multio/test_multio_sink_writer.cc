@@ -0,0 +1,119 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/Buffer.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/message/Message.h"
+#include "multio/sink/SinkWriter.h"
+
+namespace multio::test {
+
+using message::Message;
+using sink::SinkWriter;
+
+namespace {
+
+Message field(std::int64_t id) {
+    return Message{Message::Header{Message::Tag::Field, message::Peer{}, message::Peer{}, message::Metadata{{"id", id}}},
+                   eckit::Buffer{0}};
+}
+
+std::int64_t id(const SinkWriter::Item& item) {
+    return std::get<Message>(item).metadata().get<std::int64_t>("id");
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test sink writer processes writes and flushes in queue order") {
+    // Only used by the writer thread until wait() returns
+    std::vector<std::string> log;
+
+    SinkWriter writer{[&log](SinkWriter::Item item) { log.push_back("write " + std::to_string(id(item))); },
+                      [&log]() { log.push_back("flush"); }, 2, "test"};
+
+    writer.write(field(0));
+    writer.write(field(1));
+    const auto first = writer.flush();
+    writer.write(field(2));
+    const auto second = writer.flush();
+    writer.write(field(3));
+    writer.wait();
+
+    EXPECT(second == first + 1);
+    EXPECT(log == (std::vector<std::string>{"write 0", "write 1", "flush", "write 2", "flush", "write 3"}));
+}
+
+CASE("Test waiting for a flush does not wait for later writes") {
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    std::atomic<int> flushes{0};
+
+    SinkWriter writer{[gate](SinkWriter::Item item) {
+                          if (id(item) == 1) {
+                              gate.wait();
+                          }
+                      },
+                      [&flushes]() { ++flushes; }, 16, "test"};
+
+    writer.write(field(0));
+    const auto ticket = writer.flush();
+    writer.write(field(1));
+
+    // The write of field 1 is held up, the flush before it is not
+    writer.waitFlushed(ticket);
+    EXPECT(flushes == 1);
+
+    const auto next = writer.flush();
+    EXPECT(next == ticket + 1);
+
+    release.set_value();
+    writer.waitFlushed(next);
+    EXPECT(flushes == 2);
+}
+
+CASE("Test sink writer rethrows errors on the caller's side once") {
+    std::vector<std::int64_t> written;
+
+    SinkWriter writer{[&written](SinkWriter::Item item) {
+                          if (id(item) == 1) {
+                              throw eckit::SeriousBug("write failed", Here());
+                          }
+                          written.push_back(id(item));
+                      },
+                      []() {}, 16, "test"};
+
+    writer.write(field(0));
+    writer.write(field(1));
+    writer.write(field(2));
+    const auto ticket = writer.flush();
+
+    EXPECT_THROWS_AS(writer.waitFlushed(ticket), eckit::SeriousBug);
+    EXPECT_NO_THROW(writer.wait());
+
+    // Later messages are still written
+    EXPECT(written == (std::vector<std::int64_t>{0, 2}));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -0,0 +1,221 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/testing/Test.h"
+
+#include "multio/message/Metadata.h"
+#include "multio/util/ChromeTrace.h"
+#include "multio/util/TraceSpan.h"
+#include "multio/util/Tracer.h"
+
+namespace multio::test {
+
+using message::Metadata;
+using util::TraceSpan;
+using util::Tracer;
+
+namespace {
+
+struct Record {
+    std::uint64_t event;
+    std::uint64_t timestamp;
+};
+
+// Records nested action and sink write spans, the tracer writes <path>_0 when it is destroyed
+std::vector<Record> recordSpans(const std::string& path, std::uint32_t fieldKey) {
+    {
+        Tracer tracer{2, 16, path};
+        tracer.startWriterThread();
+
+        const TraceSpan action{tracer, util::MULTIO_SPAN_ACTION, fieldKey};
+        const TraceSpan write{tracer, util::MULTIO_SPAN_SINK_WRITE};
+    }
+
+    std::vector<Record> records;
+    std::ifstream in{path + "_0", std::ios::binary};
+    Record record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if (record.event != 0) {
+            records.push_back(record);
+        }
+    }
+    return records;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test field keys identify the field") {
+    const auto key = util::traceFieldKey(Metadata{{"param", "2t"}, {"level", 1}, {"step", 6}});
+
+    EXPECT(util::traceFieldKey(Metadata{{"step", 6}, {"param", "2t"}, {"level", 1}, {"date", 20240101}}) == key);
+    EXPECT(util::traceFieldKey(Metadata{{"param", "2t"}, {"level", 1}, {"step", 12}}) != key);
+
+    // Values are separated, so their boundaries matter
+    EXPECT(util::traceFieldKey(Metadata{{"param", "1"}, {"paramId", 23}})
+           != util::traceFieldKey(Metadata{{"param", "12"}, {"paramId", 3}}));
+}
+
+CASE("Test spans pack the span id, begin flag, thread and field key") {
+    const std::string path = "test_multio_trace_span.bin";
+    const auto fieldKey = util::traceFieldKey(Metadata{{"param", "2t"}, {"step", 6}});
+    const auto records = recordSpans(path, fieldKey);
+    const auto thread = util::traceThreadIndex();
+
+    struct Expected {
+        util::TraceEventIds id;
+        bool begin;
+        std::uint32_t fieldKey;
+    };
+    const std::vector<Expected> expected{{util::MULTIO_SPAN_ACTION, true, fieldKey},
+                                         {util::MULTIO_SPAN_SINK_WRITE, true, 0},
+                                         {util::MULTIO_SPAN_SINK_WRITE, false, 0},
+                                         {util::MULTIO_SPAN_ACTION, false, fieldKey}};
+
+    EXPECT(records.size() == expected.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const auto event = records[i].event;
+        EXPECT((event & (0xFFULL << 56)) == expected[i].id);
+        EXPECT(((event >> 48) & 0x1ULL) == (expected[i].begin ? 1 : 0));
+        EXPECT(((event >> 32) & 0xFFFFULL) == thread);
+        EXPECT((event & 0xFFFFFFFFULL) == expected[i].fieldKey);
+        if (i > 0) {
+            EXPECT(records[i].timestamp >= records[i - 1].timestamp);
+        }
+    }
+
+    eckit::PathName{path + "_0"}.unlink();
+}
+
+CASE("Test spans are exported as nested Chrome trace duration events") {
+    const std::string path = "test_multio_trace_span_chrome.bin";
+    const std::uint32_t fieldKey = 123456789;
+    const auto records = recordSpans(path, fieldKey);
+    EXPECT(records.size() == 4);
+
+    std::ostringstream out;
+    util::writeChromeTrace({path + "_0"}, out);
+    eckit::PathName{path + "_0"}.unlink();
+
+    std::vector<std::string> lines;
+    std::istringstream in{out.str()};
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+
+    EXPECT(lines.size() == 6);
+    EXPECT(lines.front() == "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    EXPECT(lines.back() == "]}");
+
+    // Begin and end events pair up per thread, the sink write nested within the action
+    const auto thread = std::to_string(util::traceThreadIndex());
+    const std::vector<std::pair<std::string, std::string>> expected{{"action", "B"},
+                                                                    {"sink write", "B"},
+                                                                    {"sink write", "E"},
+                                                                    {"action", "E"}};
+    for (std::size_t i = 0; i < expected.size() && i < records.size() && i + 1 < lines.size(); ++i) {
+        const auto& line = lines[i + 1];
+        const auto& [name, phase] = expected[i];
+        const auto field = std::to_string(name == "action" ? fieldKey : 0);
+
+        std::ostringstream ts;
+        ts << std::fixed << std::setprecision(3) << static_cast<double>(records[i].timestamp) * 1e-3;
+
+        const std::string event = "{\"name\":\"" + name + "\",\"cat\":\"multio\",\"ph\":\"" + phase
+                                + "\",\"ts\":" + ts.str() + ",\"pid\":0,\"tid\":" + thread
+                                + ",\"args\":{\"field\":" + field + "}}";
+        EXPECT_EQUAL(line, event + (i + 1 < expected.size() ? "," : ""));
+    }
+}
+
+CASE("Test spans of concurrent threads are all recorded across chunk switches") {
+    const std::string path = "test_multio_trace_span_threads.bin";
+    constexpr int numThreads = 8;
+    constexpr int numSpans = 500;
+
+    {
+        // Small chunks, switched many times while other threads are storing their events
+        Tracer tracer{4, 64, path};
+        tracer.startWriterThread();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&tracer, t]() {
+                for (int i = 0; i < numSpans; ++i) {
+                    const TraceSpan action{tracer, util::MULTIO_SPAN_ACTION, static_cast<std::uint32_t>(t)};
+                    const TraceSpan write{tracer, util::MULTIO_SPAN_SINK_WRITE, static_cast<std::uint32_t>(i)};
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<Record> records;
+    std::ifstream in{path + "_0", std::ios::binary};
+    for (Record record; in.read(reinterpret_cast<char*>(&record), sizeof(record));) {
+        if (record.event != 0) {
+            records.push_back(record);
+        }
+    }
+    in.close();
+    eckit::PathName{path + "_0"}.unlink();
+
+    EXPECT(records.size() == numThreads * numSpans * 4);
+
+    // Chunks switched concurrently may be written out of order, the events of a thread are in order of time
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+
+    // Every end closes the span begun last on its thread
+    constexpr std::uint64_t beginFlag = 1ULL << 48;
+    std::map<std::uint64_t, std::vector<std::uint64_t>> open;
+    std::size_t ends = 0;
+    for (const auto& record : records) {
+        auto& stack = open[(record.event >> 32) & 0xFFFFULL];
+        if (record.event & beginFlag) {
+            stack.push_back(record.event & ~beginFlag);
+            continue;
+        }
+        EXPECT(!stack.empty());
+        if (!stack.empty()) {
+            EXPECT(stack.back() == record.event);
+            stack.pop_back();
+            ++ends;
+        }
+    }
+    EXPECT(ends == numThreads * numSpans * 2);
+    EXPECT(open.size() == numThreads);
+    for (const auto& [thread, stack] : open) {
+        EXPECT(stack.empty());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}
@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 1996- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "multio/action/transport/FieldDistribution.h"
+#include "multio/message/Message.h"
+#include "multio/transport/Transport.h"
+#include "multio/util/ConsistentHash.h"
+
+namespace multio::test {
+
+using message::Message;
+using message::Metadata;
+using message::MetadataTypes;
+using message::Peer;
+
+namespace {
+
+Message field(std::int64_t level, std::int64_t globalSize, const std::string& precision) {
+    return Message{Message::Header{Message::Tag::Field, Peer{}, Peer{},
+                                   Metadata{{"category", "ocean"},
+                                            {"name", "sst"},
+                                            {"level", level},
+                                            {"globalSize", globalSize},
+                                            {"precision", precision}}}};
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("Test consistent hashing only moves keys to an added server") {
+    constexpr std::size_t numKeys = 10000;
+
+    std::vector<std::uint64_t> keys;
+    for (std::size_t i = 0; i < numKeys; ++i) {
+        util::FieldHash hash;
+        hash.add(i);
+        keys.push_back(hash.value());
+    }
+
+    for (std::size_t n = 1; n < 16; ++n) {
+        std::size_t moved = 0;
+        for (const auto key : keys) {
+            const auto before = util::jumpConsistentHash(key, n);
+            const auto after = util::jumpConsistentHash(key, n + 1);
+            EXPECT(before < n);
+            if (after != before) {
+                EXPECT(after == n);
+                ++moved;
+            }
+        }
+
+        // The new server takes about its share of the keys, all others stay where they are
+        EXPECT(moved > numKeys / (2 * (n + 1)));
+        EXPECT(moved < 2 * numKeys / (n + 1));
+    }
+}
+
+CASE("Test field weights count the bytes of the global field") {
+    EXPECT(action::fieldWeight(field(1, 1000, "double")) == 8000);
+    EXPECT(action::fieldWeight(field(1, 1000, "single")) == 4000);
+    EXPECT(action::fieldWeight(Message{Message::Header{Message::Tag::Field, Peer{}, Peer{}, Metadata{}}}) == 1);
+}
+
+CASE("Test balancing by bytes spreads mixed fields to within one field's weight") {
+    constexpr std::size_t servers = 4;
+    action::BalancedDistribution distribution{servers, true};
+
+    const std::vector<std::int64_t> globalSizes{1000, 5000, 20000, 3000};
+    std::vector<Message> fields;
+    std::uint64_t maxWeight = 0;
+    for (std::int64_t level = 1; level <= 60; ++level) {
+        fields.push_back(field(level, globalSizes[level % globalSizes.size()], (level % 3 == 0) ? "single" : "double"));
+        maxWeight = std::max(maxWeight, action::fieldWeight(fields.back()));
+    }
+
+    const std::vector<MetadataTypes::KeyType> keys{"category", "name", "level"};
+    std::vector<std::size_t> assigned;
+    for (const auto& msg : fields) {
+        assigned.push_back(distribution.server(action::fieldHash(msg.metadata(), keys), msg));
+        EXPECT(assigned.back() < servers);
+    }
+
+    const auto& loads = distribution.loads();
+    const auto [min, max] = std::minmax_element(loads.begin(), loads.end());
+    EXPECT(*max - *min <= maxWeight);
+
+    // Fields stay with their server when they are written again
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        EXPECT(distribution.server(action::fieldHash(fields[i].metadata(), keys), fields[i]) == assigned[i]);
+    }
+}
+
+CASE("Test fields with equal hash keys hash equally") {
+    const std::vector<MetadataTypes::KeyType> keys{"category", "name", "level"};
+    const auto hash = action::fieldHash(Metadata{{"category", "ocean"}, {"name", "sst"}, {"level", 1}}, keys);
+
+    // Other keys and the insertion order do not matter
+    EXPECT(action::fieldHash(Metadata{{"level", 1}, {"step", 6}, {"name", "sst"}, {"category", "ocean"}}, keys)
+           == hash);
+
+    EXPECT(action::fieldHash(Metadata{{"category", "ocean"}, {"name", "sst"}, {"level", 2}}, keys) != hash);
+    EXPECT(action::fieldHash(Metadata{{"category", "ocea"}, {"name", "nsst"}, {"level", 1}}, keys) != hash);
+
+    EXPECT_THROWS_AS(action::fieldHash(Metadata{{"category", "ocean"}, {"name", "sst"}}, keys),
+                     transport::TransportException);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace multio::test
+
+int main(int argc, char** argv) {
+    return eckit::testing::run_tests(argc, argv);
+}